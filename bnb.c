@@ -6,12 +6,55 @@
 #include <math.h>
 #include <ctype.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <time.h>
 
+// кэши степеней оснований общие для всех потоков, если есть атомарные операции C11, иначе - свои у каждого потока
+#if !defined(__STDC_NO_ATOMICS__) && !defined(_MSC_VER)
+#include <stdatomic.h>
+#define BN_CACHE_ATOMIC
+#endif
+
+#ifdef BN_COUNT_ALLOC
+// Отладочный подсчет выделений из кучи: проверка в main, что операции над короткими числами их не делают
+size_t bn_alloc_count = 0;
+void* bn_count_malloc(size_t bytes) { ++bn_alloc_count; return malloc(bytes); }
+void* bn_count_calloc(size_t count, size_t bytes) { ++bn_alloc_count; return calloc(count, bytes); }
+void* bn_count_realloc(void* ptr, size_t bytes) { ++bn_alloc_count; return realloc(ptr, bytes); }
+#define malloc bn_count_malloc
+#define calloc bn_count_calloc
+#define realloc bn_count_realloc
+#endif
+
 // ------------------------------------------ ДОПОЛНИТЕЛЬНЫЕ ФУНКЦИИ ----------------------------------------------------
 
-const unsigned int NOTATION = 1000000000; // система счисления 10 ^ n, в которой записаны числа в массив
-const int NUM = 9; // максимальное количество цифр в любой ячейке хранения
+const unsigned int NOTATION = BN_LIMB_BASE; // система счисления 10 ^ n, в которой записаны числа в массив
+const int NUM = BN_LIMB_DIGITS; // максимальное количество цифр в любой ячейке хранения
+
+const size_t BN_KARATSUBA_THRESHOLD = 32; // размер (в ячейках), начиная с которого используется метод Карацубы
+const size_t BN_TOOM3_THRESHOLD = 400; // размер (в ячейках), начиная с которого используется метод Тоома-Кука
+const size_t BN_NTT_THRESHOLD = 1000; // размер (в ячейках), начиная с которого используется умножение через NTT
+const size_t BN_SQR_KARATSUBA_THRESHOLD = 48; // размер (в ячейках), начиная с которого квадрат считается методом Карацубы
+
+// простые числа вида c * 2^k + 1 для теоретико-числового преобразования (первообразный корень 3 у всех)
+const unsigned int BN_NTT_PRIMES[3] = { 998244353, 167772161, 469762049 };
+const size_t BN_NTT_MAX_LEN = (size_t)1 << 23; // наибольшая длина преобразования, общая для всех трех модулей
+
+const size_t BN_REDC_LAZY = 16; // сколько произведений ячеек (< NOTATION^2) складывается в 64 бита без нормализации
+const size_t BN_DIV_NEWTON_THRESHOLD = 800; // длина делителя и частного, начиная с которой деление идет через обратную величину
+
+const size_t BN_SQRT_BASE_LIMBS = 4; // длина (в ячейках), до которой корень считается итерациями Ньютона от приближения по double
+const size_t BN_ROOT_BASE_LIMBS = 3; // длина корня (в ячейках), до которой он считается итерациями Ньютона от приближения по double
+const size_t BN_HGCD_THRESHOLD = 800; // длина (в ячейках), начиная с которой половинный НОД считается рекурсивно
+const size_t BN_GCD_HGCD_THRESHOLD = 3000; // длина (в ячейках), начиная с которой НОД сокращает пару через половинный НОД
+const size_t BN_PROD_LEAF = 32; // количество множителей, до которого произведение считается последовательно, без дерева
+const unsigned long long BN_BINOMIAL_SIEVE_RATIO = 16; // при n <= 16k C(n, k) собирается из степеней простых, иначе - делением
+const size_t BN_TO_STRING_THRESHOLD = 60; // длина, до которой перевод в строку идет делениями на одну ячейку
+const size_t BN_FROM_STRING_THRESHOLD = 60; // длина (в ячейках), до которой строка разбирается схемой Горнера
+#define BN_RADIX_LEVELS 48 // наибольшее количество уровней кэша степеней основания
+#define BN_MUL_STACK_LIMBS 2048 // сколько ячеек произведения и рабочей памяти Карацубы помещается на стеке
+#define BN_DIV_STACK_LIMBS 512 // сколько ячеек нормализованных операндов деления Кнута помещается на стеке
+#define BN_POWMOD_WINDOW_MAX 6 // наибольшая ширина окна при возведении в степень по модулю
 
 // Функция для преобразования символа в цифру
 int char_to_int(char);
@@ -19,42 +62,236 @@ int char_to_int(char);
 // Функция для преобразования числа в символ
 char int_to_char(int);
 
-// Функция для умножения большого числа на число типа int
-int bn_mul_int(bn*, int);
-
-// Функция деления большого числа на int, возвращающая остаток
-int bn_div_int(bn*, long long);
-
-// Функция для прибавления к большому числу положительное число типа int
-int bn_add_to_abs_int(bn*, int);
+// Функция для проверки строки числа: необязательный минус, затем только цифры системы счисления radix
+int bn_check_digits(const char* str, int radix);
 
 // Аналог присваивания
-int Analog_assignment(bn*, bn*);
+int Analog_assignment(bn*, bn const*);
 
-// Функция для нахождения расстояние между асолютными значениями чисел
-int Sub_Abs(bn*, bn const*);
+// Функция для сложения (negate = 0) или вычитания (negate = 1) с записью в dst; dst может совпадать с операндами
+int bn_add_signed_into(bn* dst, bn const*, bn const*, int negate);
 
 // Функция для нахождения произведения двух чисел школьным методом
 int bn_mul_col(bn*, bn const*);
 
+// Функция для нахождения произведения двух чисел методом Карацубы
+int bn_mul_kara(bn*, bn const*);
+
+// Функция для нахождения произведения двух чисел методом Тоома-Кука (разбиение на 3 части)
+int bn_mul_toom3(bn*, bn const*);
+
+// Функция для умножения чисел сильно различающейся длины по блокам длины меньшего
+int bn_mul_unbalanced(bn*, bn const*);
+
+// Функция для нахождения произведения двух чисел через теоретико-числовое преобразование (NTT)
+int bn_mul_ntt(bn*, bn const*);
+
+// Функция для инициализации BN неотрицательным значением из массива ячеек
+int bn_init_limbs(bn*, const int*, size_t);
+
+// Функция для записи 64-битного числа в ячейки (не больше трех), возвращает количество ячеек
+size_t bn_u64_to_limbs(int*, unsigned long long);
+
+// Функция для прибавления sign * num на месте (sign - знак слагаемого)
+int bn_add_u64(bn*, unsigned long long num, int sign);
+
+// Функция для умножения на num на месте
+int bn_mul_u64(bn*, unsigned long long num);
+
+// Функция для записи модуля числа в двоичном виде словами по 30 бит (младшие первыми);
+// count - количество слов, массив освобождается через bn_free
+unsigned int* bn_bits30(bn const*, size_t* count);
+
+// Функция для получения i-го бита числа, записанного bn_bits30
+int bn_bits30_get(const unsigned int*, size_t i);
+
+// Функция для приведения по Монтгомери: dst = t * R^(-1) mod m (t < m * R, значение t портится)
+int bn_mont_reduce(bn* dst, bn* t, bn_mont_ctx const*);
+
+// Функция для шага возведения в степень по модулю: x = x * y mod m - умножением в форме Монтгомери,
+// если задан mont, иначе умножением с приведением по Барретту (t и t2 - временные BN)
+int bn_mulmod_step(bn* x, bn const* y, bn_mont_ctx const* mont, bn_barrett const* br, bn* t, bn* t2);
+
+// Функция для приведения по Барретту: dst = x mod m (dst не совпадает с x и t, t - временный BN)
+int bn_barrett_reduce_tmp(bn* dst, bn const* x, bn_barrett const* br, bn* t);
+
+// Функция для умножения на NOTATION^k (k > 0) или деления нацело на NOTATION^(-k) (k < 0)
+int bn_shift_limbs(bn*, long);
+
+// Функция для деления модулей: q = |a| / |b|, r = |a| % |b| (выбирает метод по длине)
+int bn_divrem_abs(bn* q, bn* r, bn const* a, bn const* b);
+
+// Функция для деления с округлением вниз короткого делимого (не больше 2 * BN_INLINE_LIMBS ячеек) на короткий
+// делитель (не больше BN_INLINE_LIMBS ячеек): временные значения - на стеке, q или r может быть NULL
+int bn_divmod_short(bn* q, bn* r, bn const* a, bn const* b);
+
+// Функция для деления модулей школьным методом (алгоритм D Кнута)
+int bn_divrem_knuth(bn* q, bn* r, bn const* a, bn const* b);
+
+// Функция для деления модулей через обратную величину делителя (метод Ньютона)
+int bn_divrem_newton(bn* q, bn* r, bn const* a, bn const* b);
+
+// Функция для нахождения floor(NOTATION^(2n) / b), где n - длина b
+int bn_reciprocal(bn*, bn const*);
+
+// Функция для нахождения наибольшего k, при котором radix^k <= NOTATION (в power записывается radix^k)
+int bn_radix_chunk(int radix, int* power);
+
+// Функция для получения степени radix^(k * 2^level) из кэша (k - из bn_radix_chunk), NULL при нехватке памяти
+bn const* bn_radix_power(int radix, size_t level);
+
+// Ячейка кэша степеней: кэш заполняется лениво из любых потоков без блокировок
+#ifdef BN_CACHE_ATOMIC
+typedef _Atomic(void*) bn_cache_slot;
+#else
+typedef void* bn_cache_slot;
+#endif
+
+// Функции для ячейки кэша: bn_cache_get читает готовое значение (NULL - еще не вычислено), bn_cache_put
+// записывает значение в пустую ячейку и возвращает false, если другой поток успел записать свое раньше
+// (тогда свое значение удаляется, а используется записанное), bn_cache_take забирает значение, очищая ячейку
+void* bn_cache_get(bn_cache_slot*);
+bool bn_cache_put(bn_cache_slot*, void*);
+void* bn_cache_take(bn_cache_slot*);
+
+// Функция для записи модуля числа ровно width цифрами с ведущими нулями (модуль меньше radix^width)
+int bn_to_string_rec(bn const*, int radix, char* str, size_t width);
+
+// Функция для перевода BN в десятичную строку прямо из ячеек (каждая ячейка - ровно NUM цифр)
+char* bn_to_string_dec(bn const*);
+
+// Функция для инициализации BN модулем числа из length цифр строки str в системе счисления radix
+int bn_init_string_rec(bn*, const char* str, size_t length, int radix);
+
+// Функции над массивами ячеек (младшая ячейка первая) в дополнение к объявленным в bnb.h
+// r += a, перенос распространяется в пределах nr ячеек r, возвращается перенос из старшей ячейки
+int bn_limbs_add_to(int* r, size_t nr, const int* a, size_t na);
+
+// a /= 2 и a /= 3 на месте, возвращается остаток (для точного деления при интерполяции)
+int bn_limbs_div_2(int* a, size_t n);
+int bn_limbs_div_3(int* a, size_t n);
+
+// (a, b) = (A a + B b, C a + D b) на месте по n ячейкам, |A|, |B|, |C|, |D| < NOTATION, результаты неотрицательны;
+// в a и b записывается по n + 2 ячейки
+void bn_limbs_lehmer(int* a, int* b, size_t n, long long A, long long B, long long C, long long D);
+
+// Приведение по Монтгомери на месте: к t (2n + 1 ячеек) прибавляется u * m, делящееся на NOTATION^n;
+// m_inv = -m^(-1) mod NOTATION, частное (t + u * m) / NOTATION^n - в ячейках t[n..2n], u - в t[0..n-1]
+void bn_limbs_redc(int* t, const int* m, size_t n, int m_inv);
+
+// q = a / b, r = a % b делением Кнута (алгоритм D); na >= nb, b[nb - 1] != 0,
+// в q записывается na - nb + 1 ячеек, в r - nb ячеек (r может быть NULL)
+int bn_limbs_divrem(int* q, int* r, const int* a, size_t na, const int* b, size_t nb);
+
+// r = a * b методом Карацубы, tmp - рабочая память размера bn_limbs_karatsuba_scratch(max(na, nb))
+void bn_limbs_mul_karatsuba(int* r, const int* a, size_t na, const int* b, size_t nb, int* tmp);
+
+// r = a * a методом Карацубы (три квадрата половинной длины), tmp - память размера bn_limbs_karatsuba_scratch(n)
+void bn_limbs_sqr_karatsuba(int* r, const int* a, size_t n, int* tmp);
+
+// Размер рабочей памяти для bn_limbs_mul_karatsuba и bn_limbs_sqr_karatsuba
+size_t bn_limbs_karatsuba_scratch(size_t);
+
+// r = a * b через NTT по трем простым модулям с восстановлением по КТО, в r записывается na + nb ячеек;
+// при a == b (квадрат) делается одно прямое преобразование вместо двух
+int bn_limbs_mul_ntt(int* r, const int* a, size_t na, const int* b, size_t nb);
+
+// Функции для NTT по модулю p < 2^30 (умножение по Монтгомери, p_inv = -p^(-1) mod 2^32)
+unsigned int bn_ntt_mul(unsigned int, unsigned int, unsigned int p, unsigned int p_inv);
+unsigned int bn_ntt_pow(unsigned int, unsigned long long, unsigned int p);
+void bn_ntt(unsigned int* a, size_t n, const unsigned int* rt, unsigned int p, unsigned int p_inv);
+
 // Функиця для вычисления степени большого числа
 bn* bn_pow(bn const*, int);
 
 // Функция для добавления нулей для приведения к четному размеру массива
 int bn_add_nulls_begin(bn*, size_t);
 
+// Функция для увеличения емкости массива с запасом (не меняет размер числа)
+int bn_grow(bn*, size_t);
+
+// Функция для обмена содержимым двух больших чисел (без копирования, если память у них одного владельца)
+int bn_swap(bn*, bn*);
+
+// Функции для временного BN на стеке: bn_init_local задает значение 0 и владельца ячеек ctx (NULL - куча),
+// bn_clear_local возвращает ячейки владельцу
+void bn_init_local(bn*, bn_ctx* ctx);
+void bn_clear_local(bn*);
+
+// Функции для выделения памяти из контекста: bn_ctx_alloc - из заданного, bn_ctx_free возвращает участок
+// в контекст для следующих выделений; bn_alloc/bn_free - из контекста текущей операции или из кучи, если его нет
+void* bn_ctx_alloc(bn_ctx*, size_t);
+void bn_ctx_free(bn_ctx*, void*);
+void* bn_alloc(size_t);
+void bn_free(void*);
+
+// Функции для установки контекста текущей операции (bn_ctx_enter возвращает предыдущий для bn_ctx_leave)
+bn_ctx* bn_ctx_enter(bn_ctx*);
+void bn_ctx_leave(bn_ctx*);
+
 // Функция для удаления впереди идущих нулей большого числа
 int Clean_Nulls_Front(bn*);
 
-// Функция для сравнивания чисел с одинаковым знаком
+// Функция для сравнивания модулей чисел
 int bn_abs_cmp(bn const*, bn const*);
 
-// Функция для побитового сдвига числа вправо
-int bn_shift_right(bn*);
-
-// Функция для подсчета n-ого числа Фибоначчи
+// Функция для вывода n-ого числа Фибоначчи
 int PrintFibo(int num);
 
+// Функция для нахождения пары F(num - 1), F(num) (num >= 1) методом удвоения
+int bn_fib_pair(bn*, bn*, unsigned long long num);
+
+// Функция для нахождения произведения count множителей деревом (половины перемножаются рекурсивно):
+// i-й множитель (положительный) - arr[i], а если arr == NULL, то lo + i * step
+int bn_prod_tree(bn*, const unsigned long long* arr, unsigned long long lo, unsigned long long step, size_t count);
+
+// Функция для нахождения всех простых, не превосходящих n (решето Эратосфена);
+// count - количество простых, массив освобождается через bn_free
+unsigned long long* bn_primes(unsigned long long n, size_t* count);
+
+// Функция для нахождения C(n, k) при 0 <= k <= n
+int bn_binomial_abs(bn*, unsigned long long n, unsigned long long k);
+
+// Состояние алгоритма Евклида для НОД (определение - в разделе НОД)
+typedef struct bn_gcd_s bn_gcd_state;
+
+// Функция для замены (x, y) = (A x + B y, C x + D y) у неотрицательных x, y (|A|, |B|, |C|, |D| < NOTATION)
+int bn_lehmer_apply(bn* x, bn* y, long long A, long long B, long long C, long long D);
+
+// Функция для нахождения матрицы шага Лемера q = (A, B, C, D) по старшим цифрам a >= b:
+// частные, общие для всех чисел с такими старшими цифрами; возвращает 0, если не найдено ни одного
+int bn_lehmer_word(bn const* a, bn const* b, long long* q);
+
+// Функция для создания состояния из модулей a >> k и b >> k ячеек (|a| >= |b|): matrix - вести матрицу,
+// coef - вести коэффициенты
+int bn_gcd_init(bn_gcd_state*, bn const* a, bn const* b, size_t k, bool matrix, bool coef);
+void bn_gcd_clear(bn_gcd_state*);
+
+// Функция для проверки, что пара приведена: b не меньше всех элементов матрицы
+bool bn_gcd_reduced(bn_gcd_state const*);
+
+// Функция для одного шага: матрица Лемера или деление с остатком; если ведется матрица, шаг,
+// после которого пара перестает быть приведенной, не делается (done = false)
+int bn_gcd_step(bn_gcd_state*, bool* done);
+
+// Функция для шага с матрицей Лемера q (или любой целочисленной матрицей с определителем +-1)
+int bn_gcd_word_step(bn_gcd_state*, const long long* q);
+
+// Функция для шага деления: (a, b) = (b, a mod b)
+int bn_gcd_div_step(bn_gcd_state*, bool* done);
+
+// Функция для сокращения пары матрицей половинного НОД старших ячеек (начиная с k-й)
+int bn_hgcd_top(bn_gcd_state*, size_t k, bool* done);
+
+// Функция для нахождения половинного НОД: пара сокращается примерно вдвое, оставаясь приведенной
+int bn_hgcd(bn_gcd_state*);
+
+// Функция для сокращения пары до b = 0 (в a остается НОД)
+int bn_gcd_run(bn_gcd_state*);
+
+// Функция для dst = x1 * y1 + sign * x2 * y2 (dst не совпадает с аргументами, t - временный BN)
+int bn_dot2(bn* dst, bn const* x1, bn const* y1, bn const* x2, bn const* y2, int sign, bn* t);
+
 // Функция для вывода структуры в консоль
 int bn_print(bn const*);
 
@@ -70,37 +307,105 @@ char* GiveStr(bn const*);
 // Функция для взятия корня большого числа
 bn* bn_sqrt(bn const*);
 
+// Функция для инициализации BN целой частью неотрицательного double
+int bn_init_double(bn*, double);
+
+// Функция для нахождения корня степени k и остатка неотрицательного x: корень старших ячеек x
+// уточняется одним шагом Ньютона; s и r не должны совпадать с x
+int bn_rootrem_abs(bn* s, bn* r, bn const* x, int k);
+
+// Функция для нахождения корня и остатка неотрицательного x рекурсивным методом Ньютона
+// (корень старшей половины x уточняется одним шагом); s и r не должны совпадать с x
+int bn_sqrtrem_abs(bn* s, bn* r, bn const* x);
+
 // ------------------------------------------ КОНСТРУКТОРЫ / ДЕСТРУКТОР -----------------------------------------------------
 
+#define BN_INLINE_LIMBS 4 // количество ячеек, хранимых прямо в структуре bn
+
 /* Определения структуры bn и ее функций */
 struct bn_s {
 	int* ptr_body; // указатель на начало массива цифр
 	size_t size; // размер массива
+	size_t capacity; // количество ячеек, под которые выделена память
 	int sign; // знак числа
+	bn_ctx* ctx; // контекст, из которого выделены структура и ячейки (NULL - куча)
+	int body_inline[BN_INLINE_LIMBS]; // ячейки небольших чисел: пока число помещается, ptr_body указывает сюда
+};
+
+const size_t BN_SHRINK_MIN = 64; // емкость, ниже которой память не возвращается
+const size_t BN_SHRINK_FACTOR = 4; // во сколько раз емкость должна превышать размер для сжатия
+
+const size_t BN_CTX_BLOCK = (size_t)1 << 16; // размер первого блока контекста в байтах
+const size_t BN_CTX_ALIGN = 16; // выравнивание выделяемой из контекста памяти (и размер заголовка участка)
+const size_t BN_CTX_MIN_CLASS = 5; // участки контекста - по 2^k байт (с заголовком), не меньше 2^5
+#define BN_CTX_CLASSES 64 // количество классов размера участков контекста
+
+/* Определения контекста: блоки памяти, из которых участки выдаются подряд; освобожденный участок
+   запоминается в списке своего класса размера и выдается снова, а блоки освобождаются только целиком */
+struct bn_ctx_block_s {
+	struct bn_ctx_block_s* next; // предыдущий (более ранний) блок
+	size_t capacity; // размер области данных блока в байтах
+	size_t used; // сколько байт уже выдано
+};
+
+struct bn_ctx_s {
+	struct bn_ctx_block_s* head; // текущий блок, из него идет выделение
+	void* free_list[BN_CTX_CLASSES]; // освобожденные участки по классам размера (в участке - адрес следующего)
 };
 
+// контекст операции, выполняемой сейчас (NULL - память берется из кучи); у каждого потока - свой,
+// поэтому операция с контекстом в одном потоке не влияет на выделение памяти в других
+#if defined(_MSC_VER)
+__declspec(thread) bn_ctx* bn_ctx_current = NULL;
+#else
+_Thread_local bn_ctx* bn_ctx_current = NULL;
+#endif
+
 /* Конструктор */
 bn* bn_new() {
-	bn* ptr_bn = (bn*)malloc(sizeof(bn)); // выделем место под структуру
+	bn_ctx* ctx = bn_ctx_current; // внутри операции с контекстом память берется из него
+	bn* ptr_bn = (bn*)(ctx != NULL ? bn_ctx_alloc(ctx, sizeof(bn)) : malloc(sizeof(bn))); // выделем место под структуру
 
 	if (ptr_bn == NULL)
 	{
 		return NULL;
 	}
 
-	// создаем структуру со значением 0
+	// создаем структуру со значением 0, ячейки - внутри самой структуры
 	ptr_bn->size = 1;
+	ptr_bn->capacity = BN_INLINE_LIMBS;
 	ptr_bn->sign = 0;
-	ptr_bn->ptr_body = (int*)calloc(ptr_bn->size, sizeof(int));
+	ptr_bn->ctx = ctx;
+	ptr_bn->ptr_body = ptr_bn->body_inline;
+	ptr_bn->ptr_body[0] = 0;
 
-	if (ptr_bn->ptr_body == NULL)
+	return ptr_bn;
+}
+
+void bn_init_local(bn* Obj, bn_ctx* ctx)
+{
+	Obj->size = 1;
+	Obj->capacity = BN_INLINE_LIMBS;
+	Obj->sign = 0;
+	Obj->ctx = ctx;
+	Obj->ptr_body = Obj->body_inline;
+	Obj->ptr_body[0] = 0;
+}
+
+void bn_clear_local(bn* Obj)
+{
+	if (Obj->ptr_body != Obj->body_inline)
 	{
-		free(ptr_bn);
-		ptr_bn = NULL;
-		return NULL;
+		if (Obj->ctx != NULL)
+		{
+			bn_ctx_free(Obj->ctx, Obj->ptr_body);
+		}
+		else
+		{
+			free(Obj->ptr_body);
+		}
 	}
-
-	return ptr_bn;
+	Obj->ptr_body = NULL;
 }
 
 /* Конструктор копирования */
@@ -110,24 +415,21 @@ bn* bn_init(const bn* Obj) {
 	}
 
 	bn* ptr_cbn = bn_new();
+	if (ptr_cbn == NULL)
+	{
+		return NULL;
+	}
 
 	// Копирование значений полей структуры
-	ptr_cbn->size = Obj->size;
-	ptr_cbn->sign = Obj->sign;
-	
-	free(ptr_cbn->ptr_body);
-	ptr_cbn->ptr_body = NULL;
-
-	ptr_cbn->ptr_body = (int*)calloc(ptr_cbn->size, sizeof(int));
-	if (ptr_cbn->ptr_body == NULL) {
+	if (bn_reserve(ptr_cbn, Obj->size) != BN_OK)
+	{
 		bn_delete(ptr_cbn);
 		return NULL;
 	}
 
-	for (size_t i = 0; i < ptr_cbn->size; ++i)
-	{
-		ptr_cbn->ptr_body[i] = Obj->ptr_body[i];
-	}
+	memcpy(ptr_cbn->ptr_body, Obj->ptr_body, Obj->size * sizeof(int));
+	ptr_cbn->size = Obj->size;
+	ptr_cbn->sign = Obj->sign;
 
 	return ptr_cbn;
 }
@@ -139,6 +441,10 @@ int bn_init_string(bn* Obj, const char* str)
 	{
 		return BN_NULL_OBJECT;
 	}
+	if (bn_check_digits(str, 10) != BN_OK)
+	{
+		return BN_INVALID_ARGUMENT;
+	}
 
 	size_t length = strlen(str); // длина строки
 	size_t i = 0; // индекс текущего рассматриваемого символа
@@ -153,27 +459,26 @@ int bn_init_string(bn* Obj, const char* str)
 
 	if (i == length) // строка закончилась
 	{
+		Obj->size = 1;
+		Obj->ptr_body[0] = 0;
+		Obj->sign = 0;
 		return BN_OK;
 	}
 
-	Obj->sign = sign;
-	Obj->size = (int)ceil((double)(length - i) / NUM);
-
-	size_t k = length - NUM; // первый индекс рассматриваемой подстроки
-
-	free(Obj->ptr_body);
-	Obj->ptr_body = NULL;
-	Obj->ptr_body = (int*)calloc(Obj->size, sizeof(int));
-	if (Obj->ptr_body == NULL)
+	size_t new_size = (length - i + NUM - 1) / NUM; // количество ячеек под число
+	if (bn_grow(Obj, new_size) != BN_OK)
 	{
-		bn_delete(Obj);
 		return BN_NO_MEMORY;
 	}
 
+	Obj->sign = sign;
+	Obj->size = new_size;
+
+	size_t k = length - NUM; // первый индекс рассматриваемой подстроки
+
 	char* str_c = (char*)malloc((length + 1) * sizeof(char)); // копия исходной строки для прохода по ней со сменой некоторых значений
 	if (str_c == NULL)
 	{
-		bn_delete(Obj);
 		return BN_NO_MEMORY;
 	}
 	str_c[length] = '\0';
@@ -201,14 +506,17 @@ int bn_init_string(bn* Obj, const char* str)
 /* Функция для инициализации значения BN представлением строки в системе счисления: radix */
 int bn_init_string_radix(bn* Obj, const char* str, int radix)
 {
-	if (Obj == NULL)
+	if (Obj == NULL || str == NULL)
 	{
 		return BN_NULL_OBJECT;
 	}
-	if (radix <= 0)
+	if (radix < 2 || radix > 36 || bn_check_digits(str, radix) != BN_OK)
 	{
-		printf("\nПроверьте корректность поставляемых данных.\n");
-		return BN_OK;
+		return BN_INVALID_ARGUMENT;
+	}
+	if (radix == 10)
+	{
+		return bn_init_string(Obj, str);
 	}
 
 	size_t length = strlen(str); // длина строки
@@ -222,29 +530,19 @@ int bn_init_string_radix(bn* Obj, const char* str, int radix)
 	}
 	for (; i < length && str[i] == '0'; ++i);
 
+	Obj->size = 1;
+	Obj->ptr_body[0] = 0;
+	Obj->sign = 0;
+
 	if (i == length) // строка закончилась
 	{
 		return BN_OK;
 	}
 
-	Obj->size = 1;
-	
-
-	int res; // код результатов операций
-	for (size_t j = i; j < length; ++j)
+	int res = bn_init_string_rec(Obj, str + i, length - i, radix);
+	if (res != BN_OK)
 	{
-		res = bn_mul_int(Obj, radix);
-		if (res != BN_OK)
-		{
-			return res;
-		}
-
-
-		res = bn_add_to_abs_int(Obj, char_to_int(str[j]));
-		if (res != BN_OK)
-		{
-			return res;
-		}
+		return res;
 	}
 
 	Obj->sign = sign;
@@ -253,52 +551,53 @@ int bn_init_string_radix(bn* Obj, const char* str, int radix)
 
 /* Инициализация целым числом */
 int bn_init_int(bn* Obj, int num)
+{
+	return bn_init_int64(Obj, num);
+}
+
+/* Инициализация 64-битным целым числом */
+int bn_init_int64(bn* Obj, long long num)
 {
 	if (Obj == NULL)
 	{
 		return BN_NULL_OBJECT;
 	}
-	if (num == 0)
-	{
-		bn* Obj_null = bn_new();
-		int res_ass = Analog_assignment(Obj, Obj_null);
-		bn_delete(Obj_null);
-		return res_ass;
-	}
-
-	int num_c = abs(num);
 
-	int length = (int)ceil(log10(num_c)) + 2;
-	if (num_c != (int)pow(10.0, (double)length - 2.0))
+	// модуль считается в беззнаковом типе, чтобы не переполниться на LLONG_MIN
+	int res_err = bn_init_uint64(Obj, num < 0 ? 0ull - (unsigned long long)num : (unsigned long long)num);
+	if (res_err != BN_OK)
 	{
-		--length;
+		return res_err;
 	}
 
-	char* str = (char*)malloc(length * sizeof(char));
-	if (str == NULL)
+	if (num < 0)
 	{
-		return BN_NO_MEMORY;
+		Obj->sign = -1;
 	}
 
-	str[length - 1] = '\0';
-	for (int i = length - 2; i >= 0; --i)
+	return BN_OK;
+}
+
+/* Инициализация беззнаковым 64-битным целым числом */
+int bn_init_uint64(bn* Obj, unsigned long long num)
+{
+	if (Obj == NULL)
 	{
-		str[i] = (num_c % 10) + '0';
-		num_c /= 10;
+		return BN_NULL_OBJECT;
 	}
 
-	int res_init = bn_init_string(Obj, str);
-	free(str);
+	int arr[3];
+	size_t len = bn_u64_to_limbs(arr, num);
 
-	if (res_init != BN_OK)
+	int res_err = bn_grow(Obj, len);
+	if (res_err != BN_OK)
 	{
-		return res_init;
+		return res_err;
 	}
 
-	if (num < 0)
-	{
-		Obj->sign = -1;
-	}
+	memcpy(Obj->ptr_body, arr, len * sizeof(int));
+	Obj->size = len;
+	Obj->sign = num != 0;
 
 	return BN_OK;
 }
@@ -308,1492 +607,7028 @@ int bn_delete(bn* Obj) {
 	if (Obj == NULL) {
 		return BN_NULL_OBJECT;
 	}
+	if (Obj->ctx != NULL) // память контекста возвращается в него для следующих выделений
+	{
+		bn_ctx* ctx = Obj->ctx;
+		bn_clear_local(Obj);
+		bn_ctx_free(ctx, Obj);
+		return BN_OK;
+	}
 
-	if (Obj->ptr_body != NULL)
+	if (Obj->ptr_body != Obj->body_inline)
 	{
 		free(Obj->ptr_body);
-		Obj->ptr_body = NULL;
 	}
+	Obj->ptr_body = NULL;
 	free(Obj);
 	Obj = NULL;
 
 	return BN_OK;
 }
 
-// ------------------------------------------ ОПРЕДЕЛЕНИЯ ОСНОВНЫХ ФУНКЦИЙ ----------------------------------------------
-
-/* Функция для сравнивания двух больших чисел */
-int bn_cmp(bn const* Obj1, bn const* Obj2) {
-	if (Obj1 == NULL || Obj2 == NULL)
+/* Функция для резервирования памяти под заданное количество ячеек */
+int bn_reserve(bn* Obj, size_t capacity)
+{
+	if (Obj == NULL)
 	{
 		return BN_NULL_OBJECT;
 	}
+	if (Obj->capacity >= capacity)
+	{
+		return BN_OK;
+	}
 
-	// сравнивание по знакам
-	if (Obj1->sign > Obj2->sign)
+	int* arr = NULL;
+	if (Obj->ctx != NULL || Obj->ptr_body == Obj->body_inline)
 	{
-		return 1;
+		// старый участок контекста возвращается в него
+		arr = (int*)(Obj->ctx != NULL ? bn_ctx_alloc(Obj->ctx, capacity * sizeof(int)) : malloc(capacity * sizeof(int)));
+		if (arr != NULL)
+		{
+			memcpy(arr, Obj->ptr_body, Obj->capacity * sizeof(int));
+			if (Obj->ctx != NULL && Obj->ptr_body != Obj->body_inline)
+			{
+				bn_ctx_free(Obj->ctx, Obj->ptr_body);
+			}
+		}
 	}
-	if (Obj1->sign < Obj2->sign)
+	else
 	{
-		return -1;
+		arr = (int*)realloc(Obj->ptr_body, capacity * sizeof(int));
 	}
-	if (Obj1->sign == 0 && Obj2->sign == 0)
+	if (arr == NULL)
 	{
-		return 0;
+		return BN_NO_MEMORY;
 	}
 
-	// оба знака либо положительны, либо отрицательны
-	return bn_abs_cmp(Obj1, Obj2) * Obj1->sign;
+	Obj->ptr_body = arr;
+	Obj->capacity = capacity;
+
+	return BN_OK;
 }
 
-/* Функция для смены знака*/
-int bn_neg(bn* Obj)
+/* Функция для освобождения неиспользуемой памяти */
+int bn_shrink_to_fit(bn* Obj)
 {
 	if (Obj == NULL)
 	{
 		return BN_NULL_OBJECT;
 	}
+	if (Obj->capacity == Obj->size || Obj->ptr_body == Obj->body_inline)
+	{
+		return BN_OK;
+	}
+	if (Obj->size <= BN_INLINE_LIMBS)
+	{
+		// число снова помещается в структуру
+		memcpy(Obj->body_inline, Obj->ptr_body, Obj->size * sizeof(int));
+		bn_clear_local(Obj);
+		Obj->ptr_body = Obj->body_inline;
+		Obj->capacity = BN_INLINE_LIMBS;
+		return BN_OK;
+	}
+	if (Obj->ctx != NULL)
+	{
+		return BN_OK;
+	}
+
+	int* arr = (int*)realloc(Obj->ptr_body, Obj->size * sizeof(int));
+	if (arr == NULL)
+	{
+		return BN_NO_MEMORY;
+	}
+
+	Obj->ptr_body = arr;
+	Obj->capacity = Obj->size;
 
-	Obj->sign = -(Obj->sign);
 	return BN_OK;
 }
 
-/* Функция для взятия модуля */
-int bn_abs(bn* Obj)
+// ------------------------------------------ КОНТЕКСТ (АРЕНА) ------------------------------------------------------------
+
+/* Конструктор контекста */
+bn_ctx* bn_ctx_new()
 {
-	if (Obj == NULL)
+	bn_ctx* ctx = (bn_ctx*)malloc(sizeof(bn_ctx));
+	if (ctx == NULL)
 	{
-		return BN_NULL_OBJECT;
+		return NULL;
 	}
 
-	if (Obj->sign == -1)
+	ctx->head = NULL;
+	for (size_t i = 0; i < BN_CTX_CLASSES; ++i)
 	{
-		Obj->sign = 1;
+		ctx->free_list[i] = NULL;
 	}
-	return BN_OK;
+	return ctx;
 }
 
-/* Функция, возвращающая информацию о знаке */
-int bn_sign(bn const* Obj)
+/* Функция для освобождения всей памяти контекста (сам контекст остается пригодным) */
+int bn_ctx_clear(bn_ctx* ctx)
 {
-	if (Obj == NULL)
+	if (ctx == NULL)
 	{
 		return BN_NULL_OBJECT;
 	}
+	if (ctx->head == NULL)
+	{
+		return BN_OK;
+	}
 
-	return Obj->sign;
+	// самый новый блок - самый большой, он остается для следующих выделений
+	struct bn_ctx_block_s* block = ctx->head->next;
+	while (block != NULL)
+	{
+		struct bn_ctx_block_s* next = block->next;
+		free(block);
+		block = next;
+	}
+
+	ctx->head->next = NULL;
+	ctx->head->used = 0;
+	for (size_t i = 0; i < BN_CTX_CLASSES; ++i)
+	{
+		ctx->free_list[i] = NULL;
+	}
+
+	return BN_OK;
 }
 
-/* Функция для прибавления одного большого числа к другому */
-int bn_add_to(bn* Obj1, bn const* Obj2) {
-	if (Obj1 == NULL || Obj2 == NULL) {
+/* Деструктор контекста: вместе с ним уничтожаются все BN, созданные в нем */
+int bn_ctx_delete(bn_ctx* ctx)
+{
+	if (ctx == NULL)
+	{
 		return BN_NULL_OBJECT;
 	}
 
-	// Проверки на равенство нулю
-	if (Obj2->sign == 0)
+	struct bn_ctx_block_s* block = ctx->head;
+	while (block != NULL)
 	{
-		return BN_OK;
+		struct bn_ctx_block_s* next = block->next;
+		free(block);
+		block = next;
 	}
-	if (Obj1->sign == 0)
-	{
-		bn* Obj_c = bn_init(Obj2);
-		int res_ass = Analog_assignment(Obj1, Obj_c);
-		if (res_ass != BN_OK)
-		{
-			return res_ass;
-		}
 
-		return bn_delete(Obj_c);
-	}
+	free(ctx);
+	return BN_OK;
+}
 
-	// Сравнение знаков
-	if (Obj1->sign == Obj2->sign)
+/* Создание BN в контексте */
+bn* bn_ctx_bn_new(bn_ctx* ctx)
+{
+	if (ctx == NULL)
 	{
-		/* Добавление куска памяти с 0, для сравнивания размеров */
-		if (Obj1->size < Obj2->size)
-		{
-			int* arr = (int*)realloc(Obj1->ptr_body, Obj2->size * sizeof(int));
-			if (arr == NULL)
-			{
-				return BN_NO_MEMORY;
-			}
-			else
-			{
-				Obj1->ptr_body = arr;
+		return NULL;
+	}
+
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	bn* Obj = bn_new();
+	bn_ctx_leave(prev);
+
+	return Obj;
+}
+
+void* bn_ctx_alloc(bn_ctx* ctx, size_t bytes)
+{
+	// участок - 2^k байт, в его заголовке (BN_CTX_ALIGN байт) записан класс k
+	size_t cls = BN_CTX_MIN_CLASS;
+	for (; cls < BN_CTX_CLASSES - 1 && ((size_t)1 << cls) - BN_CTX_ALIGN < bytes; ++cls);
+	if (((size_t)1 << cls) - BN_CTX_ALIGN < bytes)
+	{
+		return NULL;
+	}
+
+	// сначала - освобожденный участок того же класса
+	char* chunk = (char*)ctx->free_list[cls];
+	if (chunk != NULL)
+	{
+		ctx->free_list[cls] = *(void**)(chunk + BN_CTX_ALIGN);
+		return chunk + BN_CTX_ALIGN;
+	}
+
+	bytes = (size_t)1 << cls;
+	size_t header = (sizeof(struct bn_ctx_block_s) + BN_CTX_ALIGN - 1) / BN_CTX_ALIGN * BN_CTX_ALIGN;
+
+	struct bn_ctx_block_s* block = ctx->head;
+	if (block == NULL || block->capacity - block->used < bytes)
+	{
+		// новый блок вдвое больше предыдущего, но не меньше запроса
+		size_t capacity = block == NULL ? BN_CTX_BLOCK : 2 * block->capacity;
+		if (capacity < bytes)
+		{
+			capacity = bytes;
+		}
+
+		struct bn_ctx_block_s* block_new = (struct bn_ctx_block_s*)malloc(header + capacity);
+		if (block_new == NULL)
+		{
+			return NULL;
+		}
+
+		block_new->next = block;
+		block_new->capacity = capacity;
+		block_new->used = 0;
+		ctx->head = block = block_new;
+	}
+
+	chunk = (char*)block + header + block->used;
+	block->used += bytes;
+
+	*(size_t*)chunk = cls;
+	return chunk + BN_CTX_ALIGN;
+}
+
+void bn_ctx_free(bn_ctx* ctx, void* ptr)
+{
+	if (ptr == NULL)
+	{
+		return;
+	}
+
+	char* chunk = (char*)ptr - BN_CTX_ALIGN;
+	size_t cls = *(size_t*)chunk;
+	*(void**)ptr = ctx->free_list[cls];
+	ctx->free_list[cls] = chunk;
+}
+
+void* bn_alloc(size_t bytes)
+{
+	return bn_ctx_current != NULL ? bn_ctx_alloc(bn_ctx_current, bytes) : malloc(bytes);
+}
+
+void bn_free(void* ptr)
+{
+	if (bn_ctx_current == NULL)
+	{
+		free(ptr);
+	}
+	else
+	{
+		bn_ctx_free(bn_ctx_current, ptr);
+	}
+}
+
+bn_ctx* bn_ctx_enter(bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_current;
+	bn_ctx_current = ctx;
+	return prev;
+}
+
+void bn_ctx_leave(bn_ctx* prev)
+{
+	bn_ctx_current = prev;
+}
+
+/* Операции, аналогичные +=, -=, *=, /=, %=, с временной памятью из контекста */
+int bn_add_to_ctx(bn* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_add_to(Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_sub_to_ctx(bn* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_sub_to(Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_mul_to_ctx(bn* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_mul_to(Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_div_to_ctx(bn* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_div_to(Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_mod_to_ctx(bn* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_mod_to(Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_divmod_ctx(bn* Obj_q, bn* Obj_r, bn const* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_divmod(Obj_q, Obj_r, Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_pow_to_ctx(bn* Obj, int degree, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_pow_to(Obj, degree);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_root_to_ctx(bn* Obj, int reciprocal, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_root_to(Obj, reciprocal);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+/* Операции с записью в dst, операции с 64-битным целым, степени, корни, НОД и ввод: временная память - из контекста */
+int bn_add_into_ctx(bn* dst, bn const* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_add_into(dst, Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_sub_into_ctx(bn* dst, bn const* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_sub_into(dst, Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_mul_into_ctx(bn* dst, bn const* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_mul_into(dst, Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_div_into_ctx(bn* dst, bn const* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_div_into(dst, Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_mod_into_ctx(bn* dst, bn const* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_mod_into(dst, Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_sqr_to_ctx(bn* Obj, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_sqr_to(Obj);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_sqr_into_ctx(bn* dst, bn const* Obj, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_sqr_into(dst, Obj);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_add_si_ctx(bn* Obj, long long num, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_add_si(Obj, num);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_sub_si_ctx(bn* Obj, long long num, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_sub_si(Obj, num);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_mul_si_ctx(bn* Obj, long long num, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_mul_si(Obj, num);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_divmod_si_ctx(bn* Obj_q, long long* rem, bn const* Obj, long long num, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_divmod_si(Obj_q, rem, Obj, num);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_powmod_ctx(bn* Obj_r, bn const* Obj_b, bn const* Obj_e, bn const* Obj_m, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_powmod(Obj_r, Obj_b, Obj_e, Obj_m);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_sqrtrem_ctx(bn* Obj_s, bn* Obj_r, bn const* Obj, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_sqrtrem(Obj_s, Obj_r, Obj);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_rootrem_ctx(bn* Obj_s, bn* Obj_r, bn const* Obj, int k, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_rootrem(Obj_s, Obj_r, Obj, k);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_fib_ctx(bn* Obj, long long num, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_fib(Obj, num);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_lucas_ctx(bn* Obj, long long num, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_lucas(Obj, num);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_fac_ctx(bn* Obj, long long num, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_fac(Obj, num);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_binomial_ctx(bn* Obj, long long num, long long k, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_binomial(Obj, num, k);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_primorial_ctx(bn* Obj, long long num, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_primorial(Obj, num);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_prod_range_ctx(bn* Obj, long long lo, long long hi, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_prod_range(Obj, lo, hi);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_gcd_ctx(bn* Obj_g, bn const* Obj_a, bn const* Obj_b, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_gcd(Obj_g, Obj_a, Obj_b);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_gcdext_ctx(bn* Obj_g, bn* Obj_s, bn* Obj_t, bn const* Obj_a, bn const* Obj_b, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_gcdext(Obj_g, Obj_s, Obj_t, Obj_a, Obj_b);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_invert_ctx(bn* Obj_r, bn const* Obj_a, bn const* Obj_m, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_invert(Obj_r, Obj_a, Obj_m);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_init_string_ctx(bn* Obj, const char* str, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_init_string(Obj, str);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_init_string_radix_ctx(bn* Obj, const char* str, int radix, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_init_string_radix(Obj, str, radix);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+bn_mont_ctx* bn_mont_ctx_new_ctx(bn const* Obj_m, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	bn_mont_ctx* mont = bn_mont_ctx_new(Obj_m);
+	bn_ctx_leave(prev);
+	return mont;
+}
+
+int bn_mont_to_ctx(bn* dst, bn const* Obj, bn_mont_ctx const* mont, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_mont_to(dst, Obj, mont);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_mont_from_ctx(bn* dst, bn const* Obj, bn_mont_ctx const* mont, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_mont_from(dst, Obj, mont);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_mont_mul_ctx(bn* dst, bn const* Obj1, bn const* Obj2, bn_mont_ctx const* mont, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_mont_mul(dst, Obj1, Obj2, mont);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+int bn_mont_sqr_ctx(bn* dst, bn const* Obj, bn_mont_ctx const* mont, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_mont_sqr(dst, Obj, mont);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+bn_barrett* bn_barrett_init_ctx(bn const* Obj_m, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	bn_barrett* br = bn_barrett_init(Obj_m);
+	bn_ctx_leave(prev);
+	return br;
+}
+
+int bn_barrett_reduce_ctx(bn* dst, bn const* Obj, bn_barrett const* br, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	int res_err = bn_barrett_reduce(dst, Obj, br);
+	bn_ctx_leave(prev);
+	return res_err;
+}
+
+/* Вывод с временной памятью из контекста: сама строка выделяется в куче и удаляется через free */
+char* bn_to_string_ctx(bn const* Obj, int radix, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	char* str = bn_to_string(Obj, radix);
+	bn_ctx_leave(prev);
+	return str;
+}
+
+/* Аналоги операций x = l+r (l-r, l*r, l/r, l%r): результат создается в контексте */
+bn* bn_add_ctx(bn const* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	bn* Obj_r = bn_add(Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return Obj_r;
+}
+
+bn* bn_sub_ctx(bn const* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	bn* Obj_r = bn_sub(Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return Obj_r;
+}
+
+bn* bn_mul_ctx(bn const* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	bn* Obj_r = bn_mul(Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return Obj_r;
+}
+
+bn* bn_div_ctx(bn const* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	bn* Obj_r = bn_div(Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return Obj_r;
+}
+
+bn* bn_mod_ctx(bn const* Obj1, bn const* Obj2, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	bn* Obj_r = bn_mod(Obj1, Obj2);
+	bn_ctx_leave(prev);
+	return Obj_r;
+}
+
+bn* bn_sqr_ctx(bn const* Obj, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	bn* Obj_r = bn_sqr(Obj);
+	bn_ctx_leave(prev);
+	return Obj_r;
+}
+
+bn* bn_init_ctx(bn const* Obj, bn_ctx* ctx)
+{
+	bn_ctx* prev = bn_ctx_enter(ctx);
+	bn* Obj_r = bn_init(Obj);
+	bn_ctx_leave(prev);
+	return Obj_r;
+}
+
+// ------------------------------------------ ОПРЕДЕЛЕНИЯ ОСНОВНЫХ ФУНКЦИЙ ----------------------------------------------
+
+/* Функция для сравнивания двух больших чисел */
+int bn_cmp(bn const* Obj1, bn const* Obj2) {
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	// сравнивание по знакам
+	if (Obj1->sign > Obj2->sign)
+	{
+		return 1;
+	}
+	if (Obj1->sign < Obj2->sign)
+	{
+		return -1;
+	}
+	if (Obj1->sign == 0 && Obj2->sign == 0)
+	{
+		return 0;
+	}
+
+	// оба знака либо положительны, либо отрицательны
+	return bn_abs_cmp(Obj1, Obj2) * Obj1->sign;
+}
+
+/* Функция для смены знака*/
+int bn_neg(bn* Obj)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	Obj->sign = -(Obj->sign);
+	return BN_OK;
+}
+
+/* Функция для взятия модуля */
+int bn_abs(bn* Obj)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	if (Obj->sign == -1)
+	{
+		Obj->sign = 1;
+	}
+	return BN_OK;
+}
+
+/* Функция, возвращающая информацию о знаке */
+int bn_sign(bn const* Obj)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	return Obj->sign;
+}
+
+/* Функции для доступа к ячейкам BN из низкоуровневого слоя */
+const int* bn_limbs_read(bn const* Obj)
+{
+	return Obj != NULL ? Obj->ptr_body : NULL;
+}
+
+size_t bn_limbs_size(bn const* Obj)
+{
+	return Obj != NULL ? Obj->size : 0;
+}
+
+int* bn_limbs_write(bn* Obj, size_t n)
+{
+	if (Obj == NULL || bn_grow(Obj, n > 0 ? n : 1) != BN_OK)
+	{
+		return NULL;
+	}
+
+	return Obj->ptr_body;
+}
+
+int bn_limbs_finish(bn* Obj, size_t n, int sign)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (n > Obj->capacity)
+	{
+		return BN_INVALID_ARGUMENT;
+	}
+	if (n == 0)
+	{
+		Obj->ptr_body[0] = 0;
+		n = 1;
+	}
+
+	Obj->size = n;
+	Obj->sign = sign < 0 ? -1 : 1;
+
+	return Clean_Nulls_Front(Obj);
+}
+
+/* Функция для прибавления одного большого числа к другому */
+int bn_add_to(bn* Obj1, bn const* Obj2) {
+	if (Obj1 == NULL || Obj2 == NULL) {
+		return BN_NULL_OBJECT;
+	}
+
+	return bn_add_signed_into(Obj1, Obj1, Obj2, 0);
+}
+
+/* Функция для вычитания из одного большого числа другое */
+int bn_sub_to(bn* Obj1, bn const* Obj2) {
+	if (Obj1 == NULL || Obj2 == NULL) {
+		return BN_NULL_OBJECT;
+	}
+
+	return bn_add_signed_into(Obj1, Obj1, Obj2, 1);
+}
+
+/* Функция для умножения из одного большого числа другое */
+int bn_mul_to(bn* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	if (Obj1->ptr_body == Obj2->ptr_body)
+	{
+		// умножение числа на само себя (в том числе на копию структуры с другим знаком) - квадрат
+		int sign = Obj1->sign * Obj2->sign;
+		int res_err = bn_sqr_into(Obj1, Obj1);
+		if (res_err == BN_OK)
+		{
+			Obj1->sign = sign;
+		}
+		return res_err;
+	}
+
+	size_t n_min = Obj1->size < Obj2->size ? Obj1->size : Obj2->size; // длина меньшего множителя
+	size_t n_max = Obj1->size < Obj2->size ? Obj2->size : Obj1->size; // длина большего множителя
+
+	// выбор метода по длине множителей
+	if (Obj1->sign == 0 || Obj2->sign == 0 || n_min < BN_KARATSUBA_THRESHOLD)
+	{
+		return bn_mul_col(Obj1, Obj2);
+	}
+	if (n_min < BN_TOOM3_THRESHOLD)
+	{
+		return bn_mul_kara(Obj1, Obj2);
+	}
+	if (n_min >= BN_NTT_THRESHOLD && n_min + n_max <= BN_NTT_MAX_LEN)
+	{
+		return bn_mul_ntt(Obj1, Obj2);
+	}
+	if (2 * n_max > 3 * n_min)
+	{
+		return bn_mul_unbalanced(Obj1, Obj2);
+	}
+
+	return bn_mul_toom3(Obj1, Obj2);
+}
+
+/* Функция для возведения числа в квадрат */
+int bn_sqr_to(bn* Obj)
+{
+	return bn_sqr_into(Obj, Obj);
+}
+
+/* Функция для деления одного большого числа на другое (с округлением вниз) */
+int bn_div_to(bn* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	return bn_divmod(Obj1, NULL, Obj1, Obj2);
+}
+
+/* Функция для взятие остатка числа */
+int bn_mod_to(bn* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	return bn_divmod(NULL, Obj1, Obj1, Obj2);
+}
+
+/* Функция для нахождения частного и остатка за одно деление */
+int bn_divmod(bn* Obj_q, bn* Obj_r, bn const* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL || (Obj_q == NULL && Obj_r == NULL))
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	if (Obj2->sign == 0)
+	{
+		return BN_DIVIDE_BY_ZERO;
+	}
+
+	if (Obj1->size <= 2 * BN_INLINE_LIMBS && Obj2->size <= BN_INLINE_LIMBS)
+	{
+		return bn_divmod_short(Obj_q, Obj_r, Obj1, Obj2);
+	}
+
+	int sign1 = Obj1->sign, sign2 = Obj2->sign; // знаки запоминаются: результаты могут совпадать с операндами
+
+	// временные числа - на стеке: частное или остаток, если они не нужны вызывающему, и копия делителя,
+	// если он будет перезаписан (она нужна только для поправки при разных знаках)
+	bn Obj_qc, Obj_rc, Obj_bc;
+	bn_init_local(&Obj_qc, bn_ctx_current);
+	bn_init_local(&Obj_rc, bn_ctx_current);
+	bn_init_local(&Obj_bc, bn_ctx_current);
+
+	bn* q = Obj_q == NULL ? &Obj_qc : Obj_q;
+	bn* r = Obj_r == NULL ? &Obj_rc : Obj_r;
+	bn const* b = Obj2;
+
+	int res_err = BN_OK;
+	if (sign1 * sign2 == -1 && (Obj2 == Obj_q || Obj2 == Obj_r))
+	{
+		res_err = Analog_assignment(&Obj_bc, Obj2);
+		b = &Obj_bc;
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = bn_divrem_abs(q, r, Obj1, Obj2); // |a| = Q * |b| + R
+	}
+
+	// при разных знаках и ненулевом остатке: |q| = Q + 1, |r| = |b| - R
+	if (res_err == BN_OK && sign1 * sign2 == -1 && r->sign != 0)
+	{
+		const int one = 1;
+		res_err = bn_add_nulls_begin(q, q->size + 1);
+		if (res_err == BN_OK)
+		{
+			bn_limbs_add_to(q->ptr_body, q->size, &one, 1);
+			q->sign = 1;
+			res_err = Clean_Nulls_Front(q);
+		}
+
+		if (res_err == BN_OK)
+		{
+			res_err = bn_add_nulls_begin(r, b->size);
+		}
+		if (res_err == BN_OK)
+		{
+			bn_limbs_sub(r->ptr_body, b->ptr_body, b->size, r->ptr_body, b->size);
+			res_err = Clean_Nulls_Front(r);
+		}
+	}
+
+	// знак частного - произведение знаков, знак остатка совпадает со знаком делителя
+	if (res_err == BN_OK && q->sign != 0)
+	{
+		q->sign = sign1 * sign2;
+	}
+	if (res_err == BN_OK && r->sign != 0)
+	{
+		r->sign = sign2;
+	}
+
+	bn_clear_local(&Obj_qc);
+	bn_clear_local(&Obj_rc);
+	bn_clear_local(&Obj_bc);
+	return res_err;
+}
+
+/* Функция для записи суммы двух чисел в dst (dst может совпадать с любым из слагаемых) */
+int bn_add_into(bn* dst, bn const* Obj1, bn const* Obj2)
+{
+	if (dst == NULL || Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	return bn_add_signed_into(dst, Obj1, Obj2, 0);
+}
+
+/* Функция для записи разности двух чисел в dst */
+int bn_sub_into(bn* dst, bn const* Obj1, bn const* Obj2)
+{
+	if (dst == NULL || Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	return bn_add_signed_into(dst, Obj1, Obj2, 1);
+}
+
+/* Функция для записи произведения двух чисел в dst */
+int bn_mul_into(bn* dst, bn const* Obj1, bn const* Obj2)
+{
+	if (dst == NULL || Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	// результат на месте одного из множителей: обычное умножение с присваиванием
+	if (dst == Obj1)
+	{
+		return bn_mul_to(dst, Obj2);
+	}
+	if (dst == Obj2)
+	{
+		return bn_mul_to(dst, Obj1);
+	}
+	if (Obj1->ptr_body == Obj2->ptr_body)
+	{
+		int sign = Obj1->sign * Obj2->sign;
+		int res_err = bn_sqr_into(dst, Obj1);
+		if (res_err == BN_OK)
+		{
+			dst->sign = sign;
+		}
+		return res_err;
+	}
+	if (Obj1->sign == 0 || Obj2->sign == 0)
+	{
+		dst->size = 1;
+		dst->ptr_body[0] = 0;
+		dst->sign = 0;
+		return BN_OK;
+	}
+
+	size_t n_r = Obj1->size + Obj2->size; // длина произведения
+	size_t n_min = Obj1->size < Obj2->size ? Obj1->size : Obj2->size;
+	size_t n_max = Obj1->size < Obj2->size ? Obj2->size : Obj1->size;
+
+	bool ntt = n_min >= BN_NTT_THRESHOLD && n_r <= BN_NTT_MAX_LEN;
+	if (n_min >= BN_TOOM3_THRESHOLD && !ntt)
+	{
+		// методы Тоома-Кука работают с BN целиком: dst становится копией первого множителя
+		int res_err = Analog_assignment(dst, Obj1);
+		if (res_err != BN_OK)
+		{
+			return res_err;
+		}
+		return bn_mul_to(dst, Obj2);
+	}
+
+	// dst не пересекается с множителями: произведение пишется прямо в его ячейки
+	int res_err = bn_grow(dst, n_r);
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	if (ntt)
+	{
+		res_err = bn_limbs_mul_ntt(dst->ptr_body, Obj1->ptr_body, Obj1->size, Obj2->ptr_body, Obj2->size);
+	}
+	else if (n_min >= BN_KARATSUBA_THRESHOLD)
+	{
+		// рабочая память - на стеке, если помещается
+		size_t n_tmp = bn_limbs_karatsuba_scratch(n_max) + 1;
+		int tmp_short[BN_MUL_STACK_LIMBS];
+		int* tmp = n_tmp > BN_MUL_STACK_LIMBS ? (int*)bn_alloc(n_tmp * sizeof(int)) : tmp_short;
+		if (tmp == NULL)
+		{
+			return BN_NO_MEMORY;
+		}
+
+		bn_limbs_mul_karatsuba(dst->ptr_body, Obj1->ptr_body, Obj1->size, Obj2->ptr_body, Obj2->size, tmp);
+		if (tmp != tmp_short)
+		{
+			bn_free(tmp);
+		}
+	}
+	else
+	{
+		bn_limbs_mul_basecase(dst->ptr_body, Obj1->ptr_body, Obj1->size, Obj2->ptr_body, Obj2->size);
+	}
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	dst->size = n_r;
+	dst->sign = Obj1->sign * Obj2->sign;
+
+	return Clean_Nulls_Front(dst);
+}
+
+/* Функция для записи квадрата числа в dst (dst может совпадать с аргументом) */
+int bn_sqr_into(bn* dst, bn const* Obj)
+{
+	if (dst == NULL || Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (Obj->sign == 0)
+	{
+		dst->size = 1;
+		dst->ptr_body[0] = 0;
+		dst->sign = 0;
+		return BN_OK;
+	}
+
+	size_t n = Obj->size;
+	if (dst == Obj || dst->ptr_body == Obj->ptr_body)
+	{
+		// ядра не работают на месте: короткий квадрат считается на стеке и копируется в dst
+		if (n <= BN_INLINE_LIMBS)
+		{
+			int arr[2 * BN_INLINE_LIMBS];
+			bn_limbs_sqr_basecase(arr, Obj->ptr_body, n);
+
+			int res_err = bn_grow(dst, 2 * n);
+			if (res_err != BN_OK)
+			{
+				return res_err;
+			}
+
+			memcpy(dst->ptr_body, arr, 2 * n * sizeof(int));
+			dst->size = 2 * n;
+			dst->sign = 1;
+			return Clean_Nulls_Front(dst);
+		}
+
+		// длинный - во временном BN на стеке с ячейками того же владельца, что у dst, и обменивается с ним
+		bn Obj_r;
+		bn_init_local(&Obj_r, dst->ctx);
+
+		int res_err = bn_sqr_into(&Obj_r, Obj);
+		if (res_err == BN_OK)
+		{
+			res_err = bn_swap(dst, &Obj_r);
+		}
+		bn_clear_local(&Obj_r);
+		return res_err;
+	}
+	if (2 * n > BN_NTT_MAX_LEN)
+	{
+		// квадрат длиннее наибольшего преобразования: общее умножение Тоома-Кука
+		int res_err = Analog_assignment(dst, Obj);
+		if (res_err != BN_OK)
+		{
+			return res_err;
+		}
+		return bn_mul_toom3(dst, Obj);
+	}
+
+	int res_err = bn_grow(dst, 2 * n);
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	if (n >= BN_NTT_THRESHOLD)
+	{
+		res_err = bn_limbs_mul_ntt(dst->ptr_body, Obj->ptr_body, n, Obj->ptr_body, n);
+	}
+	else if (n >= BN_SQR_KARATSUBA_THRESHOLD)
+	{
+		// рабочая память - на стеке, если помещается
+		size_t n_tmp = bn_limbs_karatsuba_scratch(n) + 1;
+		int tmp_short[BN_MUL_STACK_LIMBS];
+		int* tmp = n_tmp > BN_MUL_STACK_LIMBS ? (int*)bn_alloc(n_tmp * sizeof(int)) : tmp_short;
+		if (tmp == NULL)
+		{
+			return BN_NO_MEMORY;
+		}
+
+		bn_limbs_sqr_karatsuba(dst->ptr_body, Obj->ptr_body, n, tmp);
+		if (tmp != tmp_short)
+		{
+			bn_free(tmp);
+		}
+	}
+	else
+	{
+		bn_limbs_sqr_basecase(dst->ptr_body, Obj->ptr_body, n);
+	}
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	dst->size = 2 * n;
+	dst->sign = 1;
+
+	return Clean_Nulls_Front(dst);
+}
+
+/* Функция для записи частного (с округлением вниз) в dst */
+int bn_div_into(bn* dst, bn const* Obj1, bn const* Obj2)
+{
+	if (dst == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	return bn_divmod(dst, NULL, Obj1, Obj2);
+}
+
+/* Функция для записи остатка в dst */
+int bn_mod_into(bn* dst, bn const* Obj1, bn const* Obj2)
+{
+	if (dst == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	return bn_divmod(NULL, dst, Obj1, Obj2);
+}
+
+/* Функция для прибавления к большому числу 64-битного целого */
+int bn_add_si(bn* Obj, long long num)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	return bn_add_u64(Obj, num < 0 ? 0ull - (unsigned long long)num : (unsigned long long)num, (num > 0) - (num < 0));
+}
+
+/* Функция для вычитания из большого числа 64-битного целого */
+int bn_sub_si(bn* Obj, long long num)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	return bn_add_u64(Obj, num < 0 ? 0ull - (unsigned long long)num : (unsigned long long)num, (num < 0) - (num > 0));
+}
+
+/* Функция для умножения большого числа на 64-битное целое */
+int bn_mul_si(bn* Obj, long long num)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	int res_err = bn_mul_u64(Obj, num < 0 ? 0ull - (unsigned long long)num : (unsigned long long)num);
+	if (res_err == BN_OK && num < 0)
+	{
+		Obj->sign = -Obj->sign;
+	}
+
+	return res_err;
+}
+
+/* Функция для деления на 64-битное целое с округлением вниз: знак остатка совпадает со знаком делителя */
+int bn_divmod_si(bn* Obj_q, long long* rem, bn const* Obj, long long num)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (num == 0)
+	{
+		return BN_DIVIDE_BY_ZERO;
+	}
+
+	unsigned long long d = num < 0 ? 0ull - (unsigned long long)num : (unsigned long long)num;
+	int sign = Obj->sign;
+	size_t n = Obj->size;
+
+	if (Obj_q != NULL && Obj_q != Obj)
+	{
+		int res_err = bn_grow(Obj_q, n);
+		if (res_err != BN_OK)
+		{
+			return res_err;
+		}
+	}
+
+	const int* a = Obj->ptr_body;
+	int* q = Obj_q != NULL ? Obj_q->ptr_body : NULL;
+	unsigned long long curr_mod = 0;
+
+	if (d <= 0xFFFFFFFFull)
+	{
+		// curr_mod * NOTATION + a[i] < 2^32 * 10^9 < 2^64
+		for (size_t i = n; i-- > 0;)
+		{
+			unsigned long long curr = curr_mod * NOTATION + (unsigned int)a[i];
+			if (q != NULL)
+			{
+				q[i] = (int)(curr / d);
+			}
+			curr_mod = curr % d;
+		}
+	}
+	else
+	{
+#ifdef __SIZEOF_INT128__
+		for (size_t i = n; i-- > 0;)
+		{
+			unsigned __int128 curr = (unsigned __int128)curr_mod * NOTATION + (unsigned int)a[i];
+			if (q != NULL)
+			{
+				q[i] = (int)(curr / d);
+			}
+			curr_mod = (unsigned long long)(curr % d);
+		}
+#else
+		// без 128-битных целых: делитель из 2-3 ячеек, деление Кнута
+		int b[3];
+		size_t nb = bn_u64_to_limbs(b, d);
+		int r[3] = { 0, 0, 0 };
+
+		if (n < nb)
+		{
+			memcpy(r, a, n * sizeof(int));
+			if (q != NULL)
+			{
+				memset(q, 0, n * sizeof(int));
+			}
+		}
+		else
+		{
+			int* q_tmp = q;
+			if (q_tmp == NULL)
+			{
+				q_tmp = (int*)bn_alloc((n - nb + 1) * sizeof(int));
+				if (q_tmp == NULL)
+				{
+					return BN_NO_MEMORY;
+				}
+			}
+
+			int res_err = bn_limbs_divrem(q_tmp, r, a, n, b, nb);
+			if (q == NULL)
+			{
+				bn_free(q_tmp);
+			}
+			if (res_err != BN_OK)
+			{
+				return res_err;
+			}
+			if (q != NULL)
+			{
+				memset(q + n - nb + 1, 0, (nb - 1) * sizeof(int));
+			}
+		}
+
+		for (size_t i = 3; i-- > 0;)
+		{
+			curr_mod = curr_mod * NOTATION + (unsigned int)r[i];
+		}
+#endif
+	}
+
+	// переход от округления к нулю к округлению вниз
+	int round_down = curr_mod != 0 && sign * (num < 0 ? -1 : 1) < 0;
+	if (round_down)
+	{
+		curr_mod = d - curr_mod;
+	}
+
+	if (Obj_q != NULL)
+	{
+		Obj_q->size = n;
+		Obj_q->sign = sign * (num < 0 ? -1 : 1);
+
+		int res_err = Clean_Nulls_Front(Obj_q);
+		if (res_err == BN_OK && round_down)
+		{
+			// |q| + 1 при отрицательном частном
+			res_err = bn_add_u64(Obj_q, 1, -1);
+		}
+		if (res_err != BN_OK)
+		{
+			return res_err;
+		}
+	}
+
+	if (rem != NULL)
+	{
+		*rem = num < 0 ? (long long)(0ull - curr_mod) : (long long)curr_mod;
+	}
+
+	return BN_OK;
+}
+
+/* Функция для сравнения большого числа с 64-битным целым */
+int bn_cmp_si(bn const* Obj, long long num)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	int sign = (num > 0) - (num < 0);
+	if (Obj->sign != sign)
+	{
+		return Obj->sign < sign ? -1 : 1;
+	}
+
+	int arr[3];
+	size_t len = bn_u64_to_limbs(arr, num < 0 ? 0ull - (unsigned long long)num : (unsigned long long)num);
+
+	int res = 0; // сравнение модулей
+	if (Obj->size != len)
+	{
+		res = Obj->size < len ? -1 : 1;
+	}
+	else
+	{
+		res = bn_limbs_cmp(Obj->ptr_body, arr, len);
+		res = (res > 0) - (res < 0);
+	}
+
+	return sign < 0 ? -res : res;
+}
+
+/* Функция для быстрого возведения в степень */
+int bn_pow_to(bn* Obj, int degree)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	if (degree == 0) // степень - ноль 
+	{
+		return bn_init_int(Obj, 1);
+	}
+	if (degree == 1 || Obj->sign == 0)
+	{
+		return BN_OK;
+	}
+
+	int abs_degree = abs(degree); // для возведения только в неотрицательную степень
+
+	// накопитель - на стеке, его ячейки того же владельца, что у Obj, и в конце обмениваются с ним
+	bn Obj_c;
+	bn_init_local(&Obj_c, Obj->ctx);
+	Obj_c.sign = 1;
+	Obj_c.ptr_body[0] = 1;
+
+	while (abs_degree)
+	{
+		if (!(abs_degree & 1))
+		{
+			abs_degree >>= 1;
+
+			int res_mul = bn_sqr_to(Obj);
+			if (res_mul != BN_OK)
+			{
+				bn_clear_local(&Obj_c);
+				return res_mul;
+			}
+		}
+		else
+		{
+			--abs_degree;
+
+			int res_mul = bn_mul_to(&Obj_c, Obj);
+			if (res_mul != BN_OK)
+			{
+				bn_clear_local(&Obj_c);
+				return res_mul;
+			}
+		}
+	}
+
+	int res_swap = bn_swap(Obj, &Obj_c);
+	bn_clear_local(&Obj_c);
+
+	return res_swap;
+}
+
+/* Функция для возведения в степень по модулю (скользящее окно по двоичной записи показателя) */
+int bn_powmod(bn* Obj_r, bn const* Obj_b, bn const* Obj_e, bn const* Obj_m)
+{
+	if (Obj_r == NULL || Obj_b == NULL || Obj_e == NULL || Obj_m == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (Obj_m->sign == 0)
+	{
+		return BN_DIVIDE_BY_ZERO;
+	}
+	if (Obj_e->sign < 0)
+	{
+		// base^(-e) = (base^(-1))^e: основание заменяется обратным по модулю
+		bn Obj_ea = *Obj_e;
+		Obj_ea.sign = 1;
+
+		bn* Obj_inv = bn_new();
+		int res_err = Obj_inv == NULL ? BN_NO_MEMORY : bn_invert(Obj_inv, Obj_b, Obj_m);
+		if (res_err == BN_OK) res_err = bn_powmod(Obj_r, Obj_inv, &Obj_ea, Obj_m);
+
+		bn_delete(Obj_inv);
+		return res_err;
+	}
+
+	size_t n_words = 0;
+	unsigned int* bits = bn_bits30(Obj_e, &n_words); // показатель по 30 бит, младшие слова первыми
+	if (bits == NULL)
+	{
+		return BN_NO_MEMORY;
+	}
+
+	size_t n_bits = 30 * n_words; // длина показателя в битах
+	for (; n_bits > 0 && !bn_bits30_get(bits, n_bits - 1); --n_bits);
+
+	// ширина окна растет с длиной показателя: больше степеней в таблице, меньше умножений
+	size_t k = n_bits > 671 ? 6 : n_bits > 239 ? 5 : n_bits > 79 ? 4 : n_bits > 23 ? 3 : 1;
+	size_t n_table = (size_t)1 << (k - 1);
+
+	// вычисления идут по модулю |m|, знак m учитывается в самом конце
+	bn Obj_ma = *Obj_m;
+	Obj_ma.sign = 1;
+
+	// модуль, взаимно простой с NOTATION, позволяет приводить произведения по Монтгомери без делений,
+	// остальные модули приводятся по Барретту
+	bn_mont_ctx* mont = n_bits > 1 ? bn_mont_ctx_new(&Obj_ma) : NULL;
+	bn_barrett* br = n_bits > 1 && mont == NULL ? bn_barrett_init(&Obj_ma) : NULL;
+
+	bn* table[1 << (BN_POWMOD_WINDOW_MAX - 1)] = { NULL }; // table[i] = base^(2i + 1) mod m
+	bn* Obj_x = bn_new(); // накапливаемая степень (результат пишется в Obj_r только в конце: он может совпадать с аргументами)
+	bn* Obj_t = bn_new(); // произведение до приведения
+	bn* Obj_q = bn_new(); // частное приведения (не используется), затем временное значение приведения по Барретту
+	bn* Obj_sq = n_table > 1 ? bn_new() : NULL; // base^2 mod m для построения таблицы
+
+	int res_err = (Obj_x == NULL || Obj_t == NULL || Obj_q == NULL || (n_table > 1 && Obj_sq == NULL)) ? BN_NO_MEMORY : BN_OK;
+	if (n_bits > 1 && mont == NULL && br == NULL)
+	{
+		res_err = BN_NO_MEMORY;
+	}
+	for (size_t i = 0; res_err == BN_OK && i < n_table; ++i)
+	{
+		table[i] = bn_new();
+		if (table[i] == NULL)
+		{
+			res_err = BN_NO_MEMORY;
+		}
+		else if (i == 0)
+		{
+			res_err = mont != NULL ? bn_mont_to(table[0], Obj_b, mont) : bn_divmod(Obj_q, table[0], Obj_b, &Obj_ma);
+		}
+		else
+		{
+			if (i == 1)
+			{
+				res_err = Analog_assignment(Obj_sq, table[0]);
+				if (res_err == BN_OK)
+				{
+					res_err = bn_mulmod_step(Obj_sq, Obj_sq, mont, br, Obj_t, Obj_q);
+				}
+			}
+			if (res_err == BN_OK)
+			{
+				res_err = Analog_assignment(table[i], table[i - 1]);
+			}
+			if (res_err == BN_OK)
+			{
+				res_err = bn_mulmod_step(table[i], Obj_sq, mont, br, Obj_t, Obj_q);
+			}
+		}
+	}
+
+	// показатель 0: результат 1 mod m
+	if (res_err == BN_OK && n_bits == 0)
+	{
+		res_err = bn_init_int(Obj_t, 1);
+		if (res_err == BN_OK)
+		{
+			res_err = bn_divmod(Obj_q, Obj_x, Obj_t, &Obj_ma);
+		}
+	}
+
+	// биты показателя от старших к младшим: нули - возведение в квадрат, единицы начинают окно
+	bool started = false; // Obj_x уже содержит степень
+	size_t i = n_bits; // количество еще не обработанных битов
+	while (res_err == BN_OK && i > 0)
+	{
+		if (!bn_bits30_get(bits, i - 1))
+		{
+			res_err = bn_mulmod_step(Obj_x, Obj_x, mont, br, Obj_t, Obj_q);
+			--i;
+			continue;
+		}
+
+		// окно [j, i) не длиннее k битов и заканчивается единицей
+		size_t j = i > k ? i - k : 0;
+		for (; !bn_bits30_get(bits, j); ++j);
+
+		size_t val = 0; // значение окна (нечетное)
+		for (size_t l = i; l-- > j;)
+		{
+			val = (val << 1) | bn_bits30_get(bits, l);
+		}
+
+		if (!started)
+		{
+			res_err = Analog_assignment(Obj_x, table[val >> 1]);
+			started = true;
+		}
+		else
+		{
+			for (size_t l = j; res_err == BN_OK && l < i; ++l)
+			{
+				res_err = bn_mulmod_step(Obj_x, Obj_x, mont, br, Obj_t, Obj_q);
+			}
+			if (res_err == BN_OK)
+			{
+				res_err = bn_mulmod_step(Obj_x, table[val >> 1], mont, br, Obj_t, Obj_q);
+			}
+		}
+
+		i = j;
+	}
+
+	if (res_err == BN_OK && mont != NULL)
+	{
+		res_err = bn_mont_from(Obj_x, Obj_x, mont);
+	}
+
+	// остаток по отрицательному модулю: x - |m|
+	if (res_err == BN_OK && Obj_m->sign < 0 && Obj_x->sign != 0)
+	{
+		res_err = bn_sub_to(Obj_x, &Obj_ma);
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = bn_swap(Obj_r, Obj_x);
+	}
+
+	for (size_t l = 0; l < n_table; ++l)
+	{
+		bn_delete(table[l]);
+	}
+	bn_delete(Obj_x);
+	bn_delete(Obj_t);
+	bn_delete(Obj_q);
+	bn_delete(Obj_sq);
+	bn_free(bits);
+	if (mont != NULL)
+	{
+		bn_mont_ctx_delete(mont);
+	}
+	if (br != NULL)
+	{
+		bn_barrett_delete(br);
+	}
+
+	return res_err;
+}
+
+/* Функция для нахождения целого квадратного корня с остатком: x = s^2 + r, 0 <= r <= 2s */
+int bn_sqrtrem(bn* Obj_s, bn* Obj_r, bn const* Obj)
+{
+	if (Obj == NULL || (Obj_s == NULL && Obj_r == NULL))
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (Obj->sign < 0)
+	{
+		return BN_INVALID_ARGUMENT;
+	}
+
+	// корень и остаток считаются в новых BN: результаты могут совпадать с аргументом
+	bn* s = bn_new();
+	bn* r = bn_new();
+
+	int res_err = (s == NULL || r == NULL) ? BN_NO_MEMORY : BN_OK;
+	if (res_err == BN_OK) res_err = bn_sqrtrem_abs(s, r, Obj);
+	if (res_err == BN_OK && Obj_s != NULL) res_err = bn_swap(Obj_s, s);
+	if (res_err == BN_OK && Obj_r != NULL) res_err = bn_swap(Obj_r, r);
+
+	bn_delete(s);
+	bn_delete(r);
+	return res_err;
+}
+
+/* Функция для нахождения целого корня степени k с остатком: x = s^k + r, s округляется к нулю */
+int bn_rootrem(bn* Obj_s, bn* Obj_r, bn const* Obj, int k)
+{
+	if (Obj == NULL || (Obj_s == NULL && Obj_r == NULL))
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (k < 1 || (k % 2 == 0 && Obj->sign < 0))
+	{
+		return BN_INVALID_ARGUMENT;
+	}
+
+	int sign = Obj->sign; // знак запоминается: результаты могут совпадать с аргументом
+	bn Obj_a = *Obj; // |x|
+	Obj_a.sign = sign != 0;
+
+	bn* s = bn_new();
+	bn* r = bn_new();
+
+	int res_err = (s == NULL || r == NULL) ? BN_NO_MEMORY : BN_OK;
+	if (res_err == BN_OK) res_err = bn_rootrem_abs(s, r, &Obj_a, k);
+
+	// корень нечетной степени из отрицательного числа: s и r меняют знак
+	if (res_err == BN_OK && sign < 0)
+	{
+		s->sign = -s->sign;
+		r->sign = -r->sign;
+	}
+
+	if (res_err == BN_OK && Obj_s != NULL) res_err = bn_swap(Obj_s, s);
+	if (res_err == BN_OK && Obj_r != NULL) res_err = bn_swap(Obj_r, r);
+
+	bn_delete(s);
+	bn_delete(r);
+	return res_err;
+}
+
+/* Функция для взятия корня большого числа */
+int bn_root_to(bn* Obj, int root)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (root < 1 || (root % 2 == 0 && Obj->sign == -1))
+	{
+		return BN_INVALID_ARGUMENT;
+	}
+	if (Obj->sign == 0)
+	{
+		return BN_OK;
+	}
+
+	return bn_rootrem(Obj, NULL, Obj, root);
+}
+
+/* Функция для вычисления числа Фибоначчи F(num) методом удвоения (F(-n) = (-1)^(n + 1) F(n)) */
+int bn_fib(bn* Obj, long long num)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (num == 0)
+	{
+		return bn_init_int(Obj, 0);
+	}
+
+	unsigned long long abs_num = num < 0 ? 0ull - (unsigned long long)num : (unsigned long long)num;
+
+	bn* Obj_a = bn_new(); // F(|num| - 1)
+	int res_err = Obj_a == NULL ? BN_NO_MEMORY : bn_fib_pair(Obj_a, Obj, abs_num);
+	bn_delete(Obj_a);
+
+	if (res_err == BN_OK && num < 0 && abs_num % 2 == 0)
+	{
+		res_err = bn_neg(Obj);
+	}
+
+	return res_err;
+}
+
+/* Функция для вычисления числа Люка L(num) = 2F(num - 1) + F(num) (L(-n) = (-1)^n L(n)) */
+int bn_lucas(bn* Obj, long long num)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (num == 0)
+	{
+		return bn_init_int(Obj, 2);
+	}
+
+	unsigned long long abs_num = num < 0 ? 0ull - (unsigned long long)num : (unsigned long long)num;
+
+	bn* Obj_a = bn_new(); // F(|num| - 1)
+	int res_err = Obj_a == NULL ? BN_NO_MEMORY : bn_fib_pair(Obj_a, Obj, abs_num);
+	if (res_err == BN_OK) res_err = bn_add_to(Obj, Obj_a);
+	if (res_err == BN_OK) res_err = bn_add_to(Obj, Obj_a);
+	bn_delete(Obj_a);
+
+	if (res_err == BN_OK && num < 0 && abs_num % 2 == 1)
+	{
+		res_err = bn_neg(Obj);
+	}
+
+	return res_err;
+}
+
+/* Функция для вычисления факториала: нечетная часть num! собирается деревьями произведений нечетных чисел,
+   затем домножается на степень двойки */
+int bn_fac(bn* Obj, long long num)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (num < 0)
+	{
+		return BN_INVALID_ARGUMENT;
+	}
+	if (num > INT_MAX)
+	{
+		return BN_NO_MEMORY; // больше 2^31 * 31 бит - заведомо не помещается в память
+	}
+	if (num < 2)
+	{
+		return bn_init_int(Obj, 1);
+	}
+
+	unsigned long long n = (unsigned long long)num;
+
+	int bit = 0;
+	for (; (n >> bit) > 1; ++bit);
+
+	bn* Obj_p = bn_new(); // произведение нечетных чисел, не превосходящих n / 2^i
+	bn* Obj_t = bn_new();
+	int res_err = Obj_p == NULL || Obj_t == NULL ? BN_NO_MEMORY : BN_OK;
+	if (res_err == BN_OK) res_err = bn_init_int(Obj, 1);
+	if (res_err == BN_OK) res_err = bn_init_int(Obj_p, 1);
+
+	// нечетная часть n! - произведение по i >= 0 нечетных чисел из [1, n / 2^i];
+	// на шаге i к Obj_p добавляются нечетные из (n / 2^(i + 1), n / 2^i]
+	for (int i = bit; res_err == BN_OK && i >= 0; --i)
+	{
+		unsigned long long lo = (n >> (i + 1)) + 1;
+		unsigned long long hi = n >> i;
+		lo |= 1;
+		hi -= 1 - hi % 2;
+		if (lo <= hi)
+		{
+			res_err = bn_prod_tree(Obj_t, NULL, lo, 2, (size_t)((hi - lo) / 2 + 1));
+			if (res_err == BN_OK) res_err = bn_mul_to(Obj_p, Obj_t);
+		}
+
+		if (res_err == BN_OK) res_err = bn_mul_to(Obj, Obj_p);
+	}
+
+	// степень двойки в n! равна n минус количество единиц в двоичной записи n
+	int twos = (int)n;
+	for (unsigned long long m = n; m != 0; m >>= 1)
+	{
+		twos -= (int)(m & 1);
+	}
+	if (res_err == BN_OK && twos > 0)
+	{
+		res_err = bn_init_int(Obj_t, 2);
+		if (res_err == BN_OK) res_err = bn_pow_to(Obj_t, twos);
+		if (res_err == BN_OK) res_err = bn_mul_to(Obj, Obj_t);
+	}
+
+	bn_delete(Obj_p);
+	bn_delete(Obj_t);
+	return res_err;
+}
+
+/* Функция для вычисления биномиального коэффициента C(num, k); при num < 0 C(num, k) = (-1)^k C(k - num - 1, k) */
+int bn_binomial(bn* Obj, long long num, long long k)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (k < 0 || (num >= 0 && k > num))
+	{
+		return bn_init_int(Obj, 0);
+	}
+	if (num >= 0)
+	{
+		return bn_binomial_abs(Obj, (unsigned long long)num, (unsigned long long)k);
+	}
+
+	// k - num - 1 <= 2 * LLONG_MAX, в беззнаковом типе переполнения нет
+	unsigned long long n = (unsigned long long)k + (0ull - (unsigned long long)num) - 1;
+	int res_err = bn_binomial_abs(Obj, n, (unsigned long long)k);
+	if (res_err == BN_OK && k % 2 == 1)
+	{
+		res_err = bn_neg(Obj);
+	}
+
+	return res_err;
+}
+
+/* Функция для вычисления праймориала: произведения всех простых, не превосходящих num */
+int bn_primorial(bn* Obj, long long num)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (num < 0)
+	{
+		return BN_INVALID_ARGUMENT;
+	}
+
+	size_t count = 0;
+	unsigned long long* primes = bn_primes((unsigned long long)num, &count);
+	if (primes == NULL)
+	{
+		return BN_NO_MEMORY;
+	}
+
+	int res_err = bn_prod_tree(Obj, primes, 0, 0, count);
+	bn_free(primes);
+
+	return res_err;
+}
+
+/* Функция для вычисления произведения lo * (lo + 1) * ... * hi (1, если lo > hi) */
+int bn_prod_range(bn* Obj, long long lo, long long hi)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (lo > hi)
+	{
+		return bn_init_int(Obj, 1);
+	}
+	if (lo <= 0 && hi >= 0)
+	{
+		return bn_init_int(Obj, 0);
+	}
+
+	// отрезок целиком положителен или целиком отрицателен: перемножаются модули от меньшего к большему
+	unsigned long long count = (unsigned long long)hi - (unsigned long long)lo + 1;
+	unsigned long long from = lo > 0 ? (unsigned long long)lo : 0ull - (unsigned long long)hi;
+
+	int res_err = bn_prod_tree(Obj, NULL, from, 1, (size_t)count);
+	if (res_err == BN_OK && hi < 0 && count % 2 == 1)
+	{
+		res_err = bn_neg(Obj);
+	}
+
+	return res_err;
+}
+
+/* Функция для суммы двух больших чисел */
+bn* bn_add(bn const* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return NULL;
+	}
+
+	bn* Obj_r = bn_new();
+	if (Obj_r == NULL)
+	{
+		return NULL;
+	}
+
+	int code = bn_add_into(Obj_r, Obj1, Obj2);
+	if (code != BN_OK)
+	{
+		bn_delete(Obj_r);
+		return NULL;
+	}
+
+	return Obj_r;
+}
+
+/* Функция для вычитания двух больших чисел */
+bn* bn_sub(bn const* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return NULL;
+	}
+
+	bn* Obj_r = bn_new();
+	if (Obj_r == NULL)
+	{
+		return NULL;
+	}
+
+	int code = bn_sub_into(Obj_r, Obj1, Obj2);
+	if (code != BN_OK)
+	{
+		bn_delete(Obj_r);
+		return NULL;
+	}
+
+	return Obj_r;
+}
+
+/* Функиця для вычисления произведения двух больших чисел */
+bn* bn_mul(bn const* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return NULL;
+	}
+
+	bn* Obj_r = bn_new();
+	if (Obj_r == NULL)
+	{
+		return NULL;
+	}
+
+	int code = bn_mul_into(Obj_r, Obj1, Obj2);
+	if (code != BN_OK)
+	{
+		bn_delete(Obj_r);
+		return NULL;
+	}
+
+	return Obj_r;
+}
+
+/* Функция для вычисления квадрата большого числа */
+bn* bn_sqr(bn const* Obj)
+{
+	if (Obj == NULL)
+	{
+		return NULL;
+	}
+
+	bn* Obj_r = bn_new();
+	if (Obj_r == NULL)
+	{
+		return NULL;
+	}
+
+	int code = bn_sqr_into(Obj_r, Obj);
+	if (code != BN_OK)
+	{
+		bn_delete(Obj_r);
+		return NULL;
+	}
+
+	return Obj_r;
+}
+
+/* Функиця для вычисления деления двух больших чисел */
+bn* bn_div(bn const* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return NULL;
+	}
+
+	bn* Obj_r = bn_new();
+	if (Obj_r == NULL)
+	{
+		return NULL;
+	}
+
+	int code = bn_div_into(Obj_r, Obj1, Obj2);
+	if (code != BN_OK)
+	{
+		bn_delete(Obj_r);
+		return NULL;
+	}
+
+	return Obj_r;
+}
+
+/* Функиця для вычисления остатка от деления двух больших чисел */
+bn* bn_mod(bn const* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return NULL;
+	}
+
+	bn* Obj_r = bn_new();
+	if (Obj_r == NULL)
+	{
+		return NULL;
+	}
+
+	int code = bn_mod_into(Obj_r, Obj1, Obj2);
+	if (code != BN_OK)
+	{
+		bn_delete(Obj_r);
+		return NULL;
+	}
+
+	return Obj_r;
+}
+
+/* Функция для предстваления BN в некоторой системе счисления radix в виде строки */
+char* bn_to_string(bn const* Obj, int radix)
+{
+	if (Obj == NULL)
+	{
+		return NULL;
+	}
+	if (radix < 2 || radix > 36)
+	{
+		return NULL;
+	}
+	if (Obj->sign == 0)
+	{
+		char* str_r = (char*)malloc(2 * sizeof(char));
+		if (str_r == NULL)
+		{
+			return NULL;
+		}
+
+		str_r[0] = '0';
+		str_r[1] = '\0';
+		return str_r;
+	}
+
+	if (radix == 10)
+	{
+		return bn_to_string_dec(Obj);
+	}
+	if ((radix & (radix - 1)) == 0)
+	{
+		// в двоичных ячейках цифры степени двойки - это просто группы бит
+		bn_bin* Obj_bin = bn_bin_new();
+		if (Obj_bin == NULL || bn_bin_from_bn(Obj_bin, Obj) != BN_OK)
+		{
+			bn_bin_delete(Obj_bin);
+			return NULL;
+		}
+
+		char* str = bn_bin_to_string(Obj_bin, radix);
+		bn_bin_delete(Obj_bin);
+		return str;
+	}
+
+	// верхняя оценка количества цифр: |Obj| < NOTATION^size
+	size_t width = (size_t)((double)Obj->size * NUM * log(10.0) / log((double)radix)) + 2;
+	size_t ind_minus = (Obj->sign == -1);
+
+	char* str = (char*)malloc((width + ind_minus + 1) * sizeof(char));
+	if (str == NULL)
+	{
+		return NULL;
+	}
+
+	int res = bn_to_string_rec(Obj, radix, str + ind_minus, width);
+	if (res != BN_OK)
+	{
+		free(str);
+		return NULL;
+	}
+
+	// убираем ведущие нули, оставшиеся от оценки длины
+	size_t first = ind_minus;
+	while (str[first] == '0')
+	{
+		++first;
+	}
+
+	size_t len = width + ind_minus - first;
+	memmove(str + ind_minus, str + first, len);
+	if (ind_minus)
+	{
+		str[0] = '-';
+	}
+	str[ind_minus + len] = '\0';
+
+	char* str_r = (char*)realloc(str, (ind_minus + len + 1) * sizeof(char));
+	return str_r == NULL ? str : str_r;
+}
+
+// -------------------------------------- ОПРЕДЕЛЕНИЯ ДОПОЛНИТЕЛЬНЫХ ФУНКЦИЙ -------------------------------------------
+int char_to_int(char character)
+{
+	if (isdigit(character)) // если символ от 0 до 9
+	{
+		return character - '0';
+	}
+	if (isupper(character))
+	{
+		return character - 'A' + 10;
+	}
+	if (islower(character))
+	{
+		return character - 'a' + 10;
+	}
+	return BN_OK;
+}
+
+int bn_check_digits(const char* str, int radix)
+{
+	size_t i = str[0] == '-' ? 1 : 0;
+	for (; str[i] != '\0'; ++i)
+	{
+		int digit = isalnum((unsigned char)str[i]) ? char_to_int(str[i]) : radix;
+		if (digit >= radix)
+		{
+			return BN_INVALID_ARGUMENT;
+		}
+	}
+
+	return BN_OK;
+}
+
+char int_to_char(int number)
+{
+	if (number < 10)
+	{
+		return number + '0';
+	}
+	return number + 'A' - 10;
+}
+int Analog_assignment(bn* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (Obj1 == Obj2)
+	{
+		return BN_OK;
+	}
+
+	int res_err = bn_grow(Obj1, Obj2->size);
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	memcpy(Obj1->ptr_body, Obj2->ptr_body, Obj2->size * sizeof(int));
+	Obj1->size = Obj2->size;
+	Obj1->sign = Obj2->sign;
+
+	return BN_OK;
+}
+
+/* Функция для разности двух модулей */
+/* Функция для школьного перемножения */
+int bn_mul_col(bn* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_OK;
+	}
+
+	if (Obj1->sign == 0 || Obj2->sign == 0)
+	{
+		Obj1->size = 1;
+		Obj1->ptr_body[0] = 0;
+		Obj1->sign = 0;
+		return BN_OK;
+	}
+
+	// произведение считается на стеке (длинное - в выделенной памяти) и копируется в Obj1:
+	// если емкости Obj1 хватает, память не выделяется
+	size_t n_r = Obj1->size + Obj2->size;
+	int arr_short[BN_MUL_STACK_LIMBS];
+	int* arr = arr_short;
+	if (n_r > BN_MUL_STACK_LIMBS)
+	{
+		arr = (int*)bn_alloc(n_r * sizeof(int));
+		if (arr == NULL)
+		{
+			return BN_NO_MEMORY;
+		}
+	}
+
+	bn_limbs_mul_basecase(arr, Obj1->ptr_body, Obj1->size, Obj2->ptr_body, Obj2->size);
+
+	int res_err = bn_grow(Obj1, n_r);
+	if (res_err == BN_OK)
+	{
+		memcpy(Obj1->ptr_body, arr, n_r * sizeof(int));
+		Obj1->size = n_r;
+		Obj1->sign *= Obj2->sign;
+		res_err = Clean_Nulls_Front(Obj1);
+	}
+
+	if (arr != arr_short)
+	{
+		bn_free(arr);
+	}
+	return res_err;
+}
+
+/* Функция для умножения методом Карацубы */
+int bn_mul_kara(bn* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	size_t n_r = Obj1->size + Obj2->size; // длина произведения
+	size_t n_max = Obj1->size < Obj2->size ? Obj2->size : Obj1->size;
+	size_t n_tmp = bn_limbs_karatsuba_scratch(n_max) + 1;
+
+	// произведение и рабочая память - одним блоком, на стеке, если помещаются; результат копируется в Obj1
+	int arr_short[BN_MUL_STACK_LIMBS];
+	int* arr = arr_short;
+	if (n_r + n_tmp > BN_MUL_STACK_LIMBS)
+	{
+		arr = (int*)bn_alloc((n_r + n_tmp) * sizeof(int));
+		if (arr == NULL)
+		{
+			return BN_NO_MEMORY;
+		}
+	}
+
+	bn_limbs_mul_karatsuba(arr, Obj1->ptr_body, Obj1->size, Obj2->ptr_body, Obj2->size, arr + n_r);
+
+	int res_err = bn_grow(Obj1, n_r);
+	if (res_err == BN_OK)
+	{
+		memcpy(Obj1->ptr_body, arr, n_r * sizeof(int));
+		Obj1->size = n_r;
+		Obj1->sign *= Obj2->sign;
+		res_err = Clean_Nulls_Front(Obj1);
+	}
+
+	if (arr != arr_short)
+	{
+		bn_free(arr);
+	}
+	return res_err;
+}
+
+/* Функция для умножения методом Тоома-Кука (Toom-3, точки 0, 1, -1, -2, бесконечность) */
+int bn_mul_toom3(bn* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	size_t n_max = Obj1->size < Obj2->size ? Obj2->size : Obj1->size;
+	size_t k = (n_max + 2) / 3; // длина одной части
+	size_t n_r = Obj1->size + Obj2->size; // длина произведения
+	int sign = Obj1->sign * Obj2->sign;
+
+	bn* Obj_a[3]; // части первого множителя
+	bn* Obj_b[3]; // части второго множителя
+	bn* Obj_p[5]; // значения первого многочлена в точках 0, 1, -1, -2, бесконечность
+	bn* Obj_q[5]; // значения второго многочлена в тех же точках
+
+	int res_err = BN_OK;
+	for (int i = 0; i < 3; ++i)
+	{
+		Obj_a[i] = bn_new();
+		Obj_b[i] = bn_new();
+	}
+	for (int i = 0; i < 5; ++i)
+	{
+		Obj_p[i] = bn_new();
+		Obj_q[i] = bn_new();
+	}
+
+	for (int i = 0; i < 3; ++i)
+	{
+		if (Obj_a[i] == NULL || Obj_b[i] == NULL)
+		{
+			res_err = BN_NO_MEMORY;
+		}
+	}
+	for (int i = 0; i < 5; ++i)
+	{
+		if (Obj_p[i] == NULL || Obj_q[i] == NULL)
+		{
+			res_err = BN_NO_MEMORY;
+		}
+	}
+
+	for (int i = 0; i < 3 && res_err == BN_OK; ++i)
+	{
+		size_t from = i * k; // первая ячейка части
+		size_t len1 = Obj1->size > from ? Obj1->size - from : 0;
+		size_t len2 = Obj2->size > from ? Obj2->size - from : 0;
+
+		res_err = bn_init_limbs(Obj_a[i], Obj1->ptr_body + (len1 ? from : 0), len1 < k ? len1 : k);
+		if (res_err == BN_OK)
+		{
+			res_err = bn_init_limbs(Obj_b[i], Obj2->ptr_body + (len2 ? from : 0), len2 < k ? len2 : k);
+		}
+	}
+
+	// вычисление значений в точках: p(0) = a0, p(1) = a0 + a1 + a2, p(-1) = a0 - a1 + a2,
+	// p(-2) = (p(-1) + a2) * 2 - a0, p(inf) = a2
+	for (int t = 0; t < 2 && res_err == BN_OK; ++t)
+	{
+		bn** Obj_x = t == 0 ? Obj_a : Obj_b;
+		bn** Obj_v = t == 0 ? Obj_p : Obj_q;
+
+		res_err = Analog_assignment(Obj_v[0], Obj_x[0]);
+		if (res_err == BN_OK) res_err = Analog_assignment(Obj_v[1], Obj_x[0]);
+		if (res_err == BN_OK) res_err = bn_add_to(Obj_v[1], Obj_x[2]);
+		if (res_err == BN_OK) res_err = Analog_assignment(Obj_v[2], Obj_v[1]);
+		if (res_err == BN_OK) res_err = bn_sub_to(Obj_v[2], Obj_x[1]);
+		if (res_err == BN_OK) res_err = bn_add_to(Obj_v[1], Obj_x[1]);
+		if (res_err == BN_OK) res_err = Analog_assignment(Obj_v[3], Obj_v[2]);
+		if (res_err == BN_OK) res_err = bn_add_to(Obj_v[3], Obj_x[2]);
+		if (res_err == BN_OK) res_err = bn_add_to(Obj_v[3], Obj_v[3]);
+		if (res_err == BN_OK) res_err = bn_sub_to(Obj_v[3], Obj_x[0]);
+		if (res_err == BN_OK) res_err = Analog_assignment(Obj_v[4], Obj_x[2]);
+	}
+
+	// поточечное произведение: r(x) = p(x) * q(x)
+	for (int i = 0; i < 5 && res_err == BN_OK; ++i)
+	{
+		res_err = bn_mul_to(Obj_p[i], Obj_q[i]);
+	}
+
+	// интерполяция (последовательность Бодрато); в Obj_p[i] получаются коэффициенты r_i
+	if (res_err == BN_OK)
+	{
+		bn** r = Obj_p;
+		bn* Obj_t = Obj_q[0]; // временное значение r(-2)
+
+		res_err = Analog_assignment(Obj_t, r[3]);
+		if (res_err == BN_OK) res_err = bn_sub_to(Obj_t, r[1]);
+		if (res_err == BN_OK) bn_limbs_div_3(Obj_t->ptr_body, Obj_t->size); // r3 = (r(-2) - r(1)) / 3, деление точное
+		if (res_err == BN_OK) res_err = Clean_Nulls_Front(Obj_t);
+		if (res_err == BN_OK) res_err = bn_sub_to(r[1], r[2]);
+		if (res_err == BN_OK) bn_limbs_div_2(r[1]->ptr_body, r[1]->size); // r1 = (r(1) - r(-1)) / 2
+		if (res_err == BN_OK) res_err = Clean_Nulls_Front(r[1]);
+		if (res_err == BN_OK) res_err = bn_sub_to(r[2], r[0]); // r2 = r(-1) - r(0)
+		if (res_err == BN_OK) res_err = Analog_assignment(r[3], r[2]);
+		if (res_err == BN_OK) res_err = bn_sub_to(r[3], Obj_t);
+		if (res_err == BN_OK) bn_limbs_div_2(r[3]->ptr_body, r[3]->size);
+		if (res_err == BN_OK) res_err = Clean_Nulls_Front(r[3]);
+		if (res_err == BN_OK) res_err = bn_add_to(r[3], r[4]);
+		if (res_err == BN_OK) res_err = bn_add_to(r[3], r[4]); // r3 = (r2 - r3) / 2 + 2 * r(inf)
+		if (res_err == BN_OK) res_err = bn_add_to(r[2], r[1]);
+		if (res_err == BN_OK) res_err = bn_sub_to(r[2], r[4]); // r2 = r2 + r1 - r(inf)
+		if (res_err == BN_OK) res_err = bn_sub_to(r[1], r[3]); // r1 = r1 - r3
+	}
+
+	// сборка результата: сумма r_i * NOTATION^(i * k), все коэффициенты неотрицательны
+	bn* Obj_r = res_err == BN_OK ? bn_new() : NULL;
+	if (res_err == BN_OK && Obj_r == NULL)
+	{
+		res_err = BN_NO_MEMORY;
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = bn_reserve(Obj_r, n_r);
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = bn_add_nulls_begin(Obj_r, n_r);
+	}
+	for (int i = 0; i < 5 && res_err == BN_OK; ++i)
+	{
+		if (Obj_p[i]->sign != 0)
+		{
+			bn_limbs_add_to(Obj_r->ptr_body + i * k, n_r - i * k, Obj_p[i]->ptr_body, Obj_p[i]->size);
+		}
+	}
+
+	for (int i = 0; i < 3; ++i)
+	{
+		bn_delete(Obj_a[i]);
+		bn_delete(Obj_b[i]);
+	}
+	for (int i = 0; i < 5; ++i)
+	{
+		bn_delete(Obj_p[i]);
+		bn_delete(Obj_q[i]);
+	}
+
+	if (res_err != BN_OK)
+	{
+		bn_delete(Obj_r);
+		return res_err;
+	}
+
+	Obj_r->sign = sign;
+	res_err = Clean_Nulls_Front(Obj_r);
+	if (res_err == BN_OK)
+	{
+		res_err = bn_swap(Obj1, Obj_r);
+	}
+
+	bn_delete(Obj_r);
+	return res_err;
+}
+
+/* Функция для умножения чисел сильно различающейся длины */
+int bn_mul_unbalanced(bn* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	bn const* Obj_long = Obj1->size < Obj2->size ? Obj2 : Obj1; // длинный множитель
+	bn const* Obj_short = Obj1->size < Obj2->size ? Obj1 : Obj2; // короткий множитель
+	size_t n_short = Obj_short->size;
+	size_t n_r = Obj1->size + Obj2->size;
+
+	bn* Obj_r = bn_new(); // результат
+	bn* Obj_block = bn_new(); // текущий блок длинного множителя
+	int res_err = (Obj_r == NULL || Obj_block == NULL) ? BN_NO_MEMORY : BN_OK;
+
+	if (res_err == BN_OK)
+	{
+		res_err = bn_reserve(Obj_r, n_r);
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = bn_add_nulls_begin(Obj_r, n_r);
+	}
+
+	// длинный множитель режется на блоки длины короткого, каждый блок умножается отдельно
+	for (size_t from = 0; from < Obj_long->size && res_err == BN_OK; from += n_short)
+	{
+		size_t len = Obj_long->size - from < n_short ? Obj_long->size - from : n_short;
+
+		res_err = bn_init_limbs(Obj_block, Obj_long->ptr_body + from, len);
+		if (res_err == BN_OK && Obj_block->sign != 0)
+		{
+			res_err = bn_mul_to(Obj_block, Obj_short);
+			if (res_err == BN_OK)
+			{
+				bn_limbs_add_to(Obj_r->ptr_body + from, n_r - from, Obj_block->ptr_body, Obj_block->size);
+			}
+		}
+	}
+
+	bn_delete(Obj_block);
+	if (res_err != BN_OK)
+	{
+		bn_delete(Obj_r);
+		return res_err;
+	}
+
+	Obj_r->sign = Obj1->sign * Obj2->sign;
+	res_err = Clean_Nulls_Front(Obj_r);
+	if (res_err == BN_OK)
+	{
+		res_err = bn_swap(Obj1, Obj_r);
+	}
+
+	bn_delete(Obj_r);
+	return res_err;
+}
+
+/* Функция для умножения через теоретико-числовое преобразование */
+int bn_mul_ntt(bn* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	size_t n_r = Obj1->size + Obj2->size; // длина произведения
+
+	bn* Obj_r = bn_new();
+	if (Obj_r == NULL)
+	{
+		return BN_NO_MEMORY;
+	}
+
+	int res_err = bn_reserve(Obj_r, n_r);
+	if (res_err == BN_OK)
+	{
+		res_err = bn_limbs_mul_ntt(Obj_r->ptr_body, Obj1->ptr_body, Obj1->size, Obj2->ptr_body, Obj2->size);
+	}
+	if (res_err != BN_OK)
+	{
+		bn_delete(Obj_r);
+		return res_err;
+	}
+
+	Obj_r->size = n_r;
+	Obj_r->sign = Obj1->sign * Obj2->sign;
+	res_err = Clean_Nulls_Front(Obj_r);
+	if (res_err == BN_OK)
+	{
+		res_err = bn_swap(Obj1, Obj_r);
+	}
+
+	bn_delete(Obj_r);
+	return res_err;
+}
+
+int bn_shift_limbs(bn* Obj, long k)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (Obj->sign == 0 || k == 0)
+	{
+		return BN_OK;
+	}
+
+	if (k < 0)
+	{
+		size_t drop = (size_t)(-k); // количество отбрасываемых младших ячеек
+		if (drop >= Obj->size)
+		{
+			Obj->size = 1;
+			Obj->ptr_body[0] = 0;
+			Obj->sign = 0;
+			return BN_OK;
+		}
+
+		memmove(Obj->ptr_body, Obj->ptr_body + drop, (Obj->size - drop) * sizeof(int));
+		Obj->size -= drop;
+		return BN_OK;
+	}
+
+	int res_err = bn_grow(Obj, Obj->size + k);
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	memmove(Obj->ptr_body + k, Obj->ptr_body, Obj->size * sizeof(int));
+	memset(Obj->ptr_body, 0, k * sizeof(int));
+	Obj->size += k;
+
+	return BN_OK;
+}
+
+/* Функция для деления модулей */
+int bn_divrem_abs(bn* Obj_q, bn* Obj_r, bn const* Obj1, bn const* Obj2)
+{
+	if (Obj_q == NULL || Obj_r == NULL || Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (Obj2->sign == 0)
+	{
+		return BN_DIVIDE_BY_ZERO;
+	}
+
+	// |a| < |b|: частное 0, остаток |a|
+	if (Obj1->size < Obj2->size || (Obj1->size == Obj2->size && bn_limbs_cmp(Obj1->ptr_body, Obj2->ptr_body, Obj1->size) < 0))
+	{
+		int res_err = Analog_assignment(Obj_r, Obj1);
+		bn_abs(Obj_r);
+
+		Obj_q->size = 1;
+		Obj_q->ptr_body[0] = 0;
+		Obj_q->sign = 0;
+		return res_err;
+	}
+
+	if (Obj2->size >= BN_DIV_NEWTON_THRESHOLD && Obj1->size - Obj2->size >= BN_DIV_NEWTON_THRESHOLD)
+	{
+		return bn_divrem_newton(Obj_q, Obj_r, Obj1, Obj2);
+	}
+
+	return bn_divrem_knuth(Obj_q, Obj_r, Obj1, Obj2);
+}
+
+int bn_divmod_short(bn* Obj_q, bn* Obj_r, bn const* Obj1, bn const* Obj2)
+{
+	int arr_q[2 * BN_INLINE_LIMBS + 1] = { 0 }; // модуль частного (с ячейкой под перенос)
+	int arr_r[BN_INLINE_LIMBS] = { 0 }; // модуль остатка
+	int sign1 = Obj1->sign, sign2 = Obj2->sign;
+	size_t na = Obj1->size, nb = Obj2->size, nq = 1;
+
+	int cmp = na != nb ? (na < nb ? -1 : 1) : bn_limbs_cmp(Obj1->ptr_body, Obj2->ptr_body, na);
+	if (cmp < 0)
+	{
+		memcpy(arr_r, Obj1->ptr_body, na * sizeof(int)); // |a| < |b|: частное 0, остаток |a|
+	}
+	else
+	{
+		nq = na - nb + 1;
+		int res_err = bn_limbs_divrem(arr_q, arr_r, Obj1->ptr_body, na, Obj2->ptr_body, nb);
+		if (res_err != BN_OK)
+		{
+			return res_err;
+		}
+	}
+
+	// при разных знаках и ненулевом остатке: |q| = Q + 1, |r| = |b| - R
+	if (sign1 * sign2 == -1 && bn_limbs_normalize(arr_r, nb) != 0)
+	{
+		arr_q[nq] = bn_limbs_add_1(arr_q, arr_q, nq, 1);
+		++nq;
+		bn_limbs_sub(arr_r, Obj2->ptr_body, nb, arr_r, nb);
+	}
+
+	// результаты пишутся после чтения аргументов: они могут совпадать
+	int res_err = BN_OK;
+	if (Obj_q != NULL)
+	{
+		res_err = bn_init_limbs(Obj_q, arr_q, nq);
+		if (res_err == BN_OK && Obj_q->sign != 0)
+		{
+			Obj_q->sign = sign1 * sign2;
+		}
+	}
+	if (res_err == BN_OK && Obj_r != NULL)
+	{
+		res_err = bn_init_limbs(Obj_r, arr_r, nb);
+		if (res_err == BN_OK && Obj_r->sign != 0)
+		{
+			Obj_r->sign = sign2;
+		}
+	}
+
+	return res_err;
+}
+
+/* Функция для деления модулей алгоритмом D Кнута */
+int bn_divrem_knuth(bn* Obj_q, bn* Obj_r, bn const* Obj1, bn const* Obj2)
+{
+	size_t n_a = Obj1->size, n_b = Obj2->size;
+	size_t n_q = n_a - n_b + 1; // длина частного
+
+	// ядро читает операнды до записи результатов, поэтому q и r могут быть самими a и b; временные
+	// числа на стеке нужны, только если q и r совпадают или делят ячейки с другой структурой (копией a или b)
+	bool direct = Obj_q != Obj_r
+		&& (Obj_q->ptr_body != Obj1->ptr_body || Obj_q == Obj1) && (Obj_q->ptr_body != Obj2->ptr_body || Obj_q == Obj2)
+		&& (Obj_r->ptr_body != Obj1->ptr_body || Obj_r == Obj1) && (Obj_r->ptr_body != Obj2->ptr_body || Obj_r == Obj2);
+
+	bn Obj_qc, Obj_rc;
+	bn_init_local(&Obj_qc, Obj_q->ctx);
+	bn_init_local(&Obj_rc, Obj_r->ctx);
+	bn* q = direct ? Obj_q : &Obj_qc;
+	bn* r = direct ? Obj_r : &Obj_rc;
+
+	// указатели на ячейки операндов берутся после роста результатов: он может перенести ячейки a или b
+	int res_err = bn_grow(q, n_q + 1);
+	if (res_err == BN_OK)
+	{
+		res_err = bn_grow(r, n_b);
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = bn_limbs_divrem(q->ptr_body, r->ptr_body, Obj1->ptr_body, n_a, Obj2->ptr_body, n_b);
+	}
+	if (res_err == BN_OK)
+	{
+		q->size = n_q;
+		q->sign = 1;
+		r->size = n_b;
+		r->sign = 1;
+
+		res_err = Clean_Nulls_Front(q);
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = Clean_Nulls_Front(r);
+	}
+
+	if (res_err == BN_OK && !direct)
+	{
+		res_err = bn_swap(Obj_q, &Obj_qc);
+		if (res_err == BN_OK)
+		{
+			res_err = bn_swap(Obj_r, &Obj_rc);
+		}
+	}
+	bn_clear_local(&Obj_qc);
+	bn_clear_local(&Obj_rc);
+	return res_err;
+}
+
+/* Функция для деления модулей через обратную величину делителя */
+int bn_divrem_newton(bn* Obj_q, bn* Obj_r, bn const* Obj1, bn const* Obj2)
+{
+	size_t n = Obj2->size; // длина делителя и одного блока делимого
+	size_t k = (Obj1->size + n - 1) / n; // количество блоков делимого
+
+	bn* Obj_b = bn_init(Obj2); // |b|
+	bn* Obj_x = bn_new(); // floor(NOTATION^(2n) / b)
+	bn* Obj_cur = bn_new(); // текущее делимое: остаток * NOTATION^n + очередной блок
+	bn* Obj_qi = bn_new(); // текущий блок частного
+	bn* Obj_t = bn_new(); // временное значение
+	bn* Obj_qc = bn_new(); // частное
+	bn* Obj_rc = bn_new(); // остаток
+	bn* Obj_ed = bn_new(); // единица
+
+	int res_err = (Obj_b == NULL || Obj_x == NULL || Obj_cur == NULL || Obj_qi == NULL
+		|| Obj_t == NULL || Obj_qc == NULL || Obj_rc == NULL || Obj_ed == NULL) ? BN_NO_MEMORY : BN_OK;
+
+	if (res_err == BN_OK)
+	{
+		Obj_ed->sign = 1;
+		Obj_ed->ptr_body[0] = 1;
+
+		bn_abs(Obj_b);
+		res_err = bn_reciprocal(Obj_x, Obj_b);
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = bn_add_nulls_begin(Obj_qc, k * n);
+	}
+
+	// деление блоками по n ячеек от старших к младшим; на каждом шаге текущее делимое меньше b * NOTATION^n
+	for (size_t i = k; i-- > 0 && res_err == BN_OK;)
+	{
+		size_t len = i == k - 1 ? Obj1->size - i * n : n; // длина блока
+
+		res_err = bn_init_limbs(Obj_t, Obj1->ptr_body + i * n, len);
+		if (res_err == BN_OK) res_err = Analog_assignment(Obj_cur, Obj_rc);
+		if (res_err == BN_OK) res_err = bn_shift_limbs(Obj_cur, (long)n);
+		if (res_err == BN_OK) res_err = bn_add_to(Obj_cur, Obj_t);
+
+		// оценка частного снизу: q_i = floor(cur * x / NOTATION^(2n)), ошибка - несколько единиц
+		if (res_err == BN_OK) res_err = Analog_assignment(Obj_qi, Obj_cur);
+		if (res_err == BN_OK) res_err = bn_mul_to(Obj_qi, Obj_x);
+		if (res_err == BN_OK) res_err = bn_shift_limbs(Obj_qi, -2 * (long)n);
+
+		if (res_err == BN_OK) res_err = Analog_assignment(Obj_rc, Obj_qi);
+		if (res_err == BN_OK) res_err = bn_mul_to(Obj_rc, Obj_b);
+		if (res_err == BN_OK) res_err = bn_sub_to(Obj_rc, Obj_cur);
+		if (res_err == BN_OK) res_err = bn_neg(Obj_rc); // r = cur - q_i * b
+
+		// коррекция оценки
+		while (res_err == BN_OK && bn_cmp(Obj_rc, Obj_b) >= 0)
+		{
+			res_err = bn_sub_to(Obj_rc, Obj_b);
+			if (res_err == BN_OK) res_err = bn_add_to(Obj_qi, Obj_ed);
+		}
+
+		if (res_err == BN_OK && Obj_qi->sign != 0)
+		{
+			memcpy(Obj_qc->ptr_body + i * n, Obj_qi->ptr_body, Obj_qi->size * sizeof(int));
+		}
+	}
+
+	if (res_err == BN_OK)
+	{
+		Obj_qc->sign = 1;
+		res_err = Clean_Nulls_Front(Obj_qc);
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = bn_swap(Obj_q, Obj_qc);
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = bn_swap(Obj_r, Obj_rc);
+	}
+
+	bn_delete(Obj_b);
+	bn_delete(Obj_x);
+	bn_delete(Obj_cur);
+	bn_delete(Obj_qi);
+	bn_delete(Obj_t);
+	bn_delete(Obj_qc);
+	bn_delete(Obj_rc);
+	bn_delete(Obj_ed);
+	return res_err;
+}
+
+/* Функция для нахождения обратной величины: итерации Ньютона с удвоением точности */
+int bn_reciprocal(bn* Obj_x, bn const* Obj_b)
+{
+	size_t n = Obj_b->size;
+
+	bn* Obj_num = bn_new(); // NOTATION^(2n)
+	bn* Obj_t = bn_new(); // временное значение
+	bn* Obj_ed = bn_new(); // единица
+	int res_err = (Obj_num == NULL || Obj_t == NULL || Obj_ed == NULL) ? BN_NO_MEMORY : BN_OK;
+
+	if (res_err == BN_OK)
+	{
+		res_err = bn_add_nulls_begin(Obj_num, 2 * n + 1);
+	}
+	if (res_err == BN_OK)
+	{
+		Obj_num->ptr_body[2 * n] = 1;
+		Obj_num->sign = 1;
+
+		Obj_ed->sign = 1;
+		Obj_ed->ptr_body[0] = 1;
+	}
+
+	if (res_err == BN_OK && n < BN_DIV_NEWTON_THRESHOLD) // короткий делитель: прямое деление
+	{
+		res_err = bn_divrem_knuth(Obj_x, Obj_t, Obj_num, Obj_b);
+
+		bn_delete(Obj_num);
+		bn_delete(Obj_t);
+		bn_delete(Obj_ed);
+		return res_err;
+	}
+
+	// начальное приближение - обратная величина старших h ячеек (с запасом в две ячейки)
+	size_t h = (n + 1) / 2 + 2;
+	if (res_err == BN_OK) res_err = bn_init_limbs(Obj_t, Obj_b->ptr_body + n - h, h);
+	if (res_err == BN_OK) res_err = bn_reciprocal(Obj_x, Obj_t);
+	if (res_err == BN_OK) res_err = bn_shift_limbs(Obj_x, (long)(n - h));
+
+	// шаг Ньютона: x = 2x - floor(b * x^2 / NOTATION^(2n))
+	if (res_err == BN_OK) res_err = Analog_assignment(Obj_t, Obj_x);
+	if (res_err == BN_OK) res_err = bn_mul_to(Obj_t, Obj_x);
+	if (res_err == BN_OK) res_err = bn_mul_to(Obj_t, Obj_b);
+	if (res_err == BN_OK) res_err = bn_shift_limbs(Obj_t, -2 * (long)n);
+	if (res_err == BN_OK) res_err = bn_add_to(Obj_x, Obj_x);
+	if (res_err == BN_OK) res_err = bn_sub_to(Obj_x, Obj_t);
+
+	// коррекция: остаток NOTATION^(2n) - b * x должен лежать в [0, b)
+	if (res_err == BN_OK) res_err = Analog_assignment(Obj_t, Obj_x);
+	if (res_err == BN_OK) res_err = bn_mul_to(Obj_t, Obj_b);
+	if (res_err == BN_OK) res_err = bn_sub_to(Obj_num, Obj_t);
+
+	while (res_err == BN_OK && Obj_num->sign < 0)
+	{
+		res_err = bn_add_to(Obj_num, Obj_b);
+		if (res_err == BN_OK) res_err = bn_sub_to(Obj_x, Obj_ed);
+	}
+	while (res_err == BN_OK && bn_cmp(Obj_num, Obj_b) >= 0)
+	{
+		res_err = bn_sub_to(Obj_num, Obj_b);
+		if (res_err == BN_OK) res_err = bn_add_to(Obj_x, Obj_ed);
+	}
+
+	bn_delete(Obj_num);
+	bn_delete(Obj_t);
+	bn_delete(Obj_ed);
+	return res_err;
+}
+
+// кэш степеней radix^(k * 2^level), общий для всех вызовов (очищается в bn_cache_clear)
+#ifdef BN_CACHE_ATOMIC
+bn_cache_slot bn_radix_powers[37][BN_RADIX_LEVELS];
+#elif defined(_MSC_VER)
+__declspec(thread) bn_cache_slot bn_radix_powers[37][BN_RADIX_LEVELS];
+#else
+_Thread_local bn_cache_slot bn_radix_powers[37][BN_RADIX_LEVELS];
+#endif
+
+void* bn_cache_get(bn_cache_slot* slot)
+{
+#ifdef BN_CACHE_ATOMIC
+	return atomic_load_explicit(slot, memory_order_acquire);
+#else
+	return *slot;
+#endif
+}
+
+bool bn_cache_put(bn_cache_slot* slot, void* value)
+{
+#ifdef BN_CACHE_ATOMIC
+	void* expected = NULL;
+	return atomic_compare_exchange_strong_explicit(slot, &expected, value, memory_order_acq_rel, memory_order_acquire);
+#else
+	*slot = value;
+	return true;
+#endif
+}
+
+void* bn_cache_take(bn_cache_slot* slot)
+{
+#ifdef BN_CACHE_ATOMIC
+	return atomic_exchange_explicit(slot, NULL, memory_order_acq_rel);
+#else
+	void* value = *slot;
+	*slot = NULL;
+	return value;
+#endif
+}
+
+int bn_radix_chunk(int radix, int* power)
+{
+	int k = 0;
+	long long curr = 1;
+	while (curr * radix <= (long long)NOTATION)
+	{
+		curr *= radix;
+		++k;
+	}
+
+	*power = (int)curr;
+	return k;
+}
+
+bn const* bn_radix_power(int radix, size_t level)
+{
+	if (level >= BN_RADIX_LEVELS)
+	{
+		return NULL;
+	}
+
+	bn_cache_slot* powers = bn_radix_powers[radix];
+	bn const* Obj_level = (bn const*)bn_cache_get(&powers[level]);
+	if (Obj_level != NULL)
+	{
+		return Obj_level;
+	}
+
+	bn_ctx* prev = bn_ctx_enter(NULL); // кэш живет дольше любого контекста, его память берется из кучи
+	for (size_t j = 0; j <= level; ++j)
+	{
+		if (bn_cache_get(&powers[j]) != NULL)
+		{
+			continue;
+		}
+
+		bn* Obj_p = NULL;
+		if (j == 0)
+		{
+			int power = 0;
+			bn_radix_chunk(radix, &power);
+
+			// radix^k = NOTATION (для radix = 10) занимает две ячейки
+			int limbs[2] = { power, 0 };
+			if (power == (int)NOTATION)
+			{
+				limbs[0] = 0;
+				limbs[1] = 1;
+			}
+
+			Obj_p = bn_new();
+			if (Obj_p == NULL || bn_init_limbs(Obj_p, limbs, limbs[1] == 0 ? 1 : 2) != BN_OK)
+			{
+				bn_delete(Obj_p);
+				bn_ctx_leave(prev);
+				return NULL;
+			}
+		}
+		else
+		{
+			// следующий уровень - квадрат предыдущего
+			bn const* Obj_prev = (bn const*)bn_cache_get(&powers[j - 1]);
+			Obj_p = bn_init(Obj_prev);
+			if (Obj_p == NULL || bn_mul_to(Obj_p, Obj_prev) != BN_OK)
+			{
+				bn_delete(Obj_p);
+				bn_ctx_leave(prev);
+				return NULL;
+			}
+		}
+
+		if (!bn_cache_put(&powers[j], Obj_p))
+		{
+			bn_delete(Obj_p); // уровень уже вычислил другой поток
+		}
+	}
+
+	bn_ctx_leave(prev);
+	return (bn const*)bn_cache_get(&powers[level]);
+}
+
+char* bn_to_string_dec(bn const* Obj)
+{
+	// старшая ячейка пишется без ведущих нулей, остальные - ровно NUM цифрами
+	int top = Obj->ptr_body[Obj->size - 1];
+	size_t top_len = 1;
+	for (int t = top; t >= 10; t /= 10)
+	{
+		++top_len;
+	}
+
+	size_t ind_minus = (Obj->sign == -1);
+	size_t len = ind_minus + top_len + (Obj->size - 1) * NUM;
+
+	char* str = (char*)malloc((len + 1) * sizeof(char));
+	if (str == NULL)
+	{
+		return NULL;
+	}
+
+	if (ind_minus)
+	{
+		str[0] = '-';
+	}
+	str[len] = '\0';
+
+	char* curr = str + len;
+	for (size_t i = 0; i + 1 < Obj->size; ++i)
+	{
+		unsigned int limb = (unsigned int)Obj->ptr_body[i];
+		for (int j = 0; j < NUM; ++j)
+		{
+			*(--curr) = (char)('0' + limb % 10);
+			limb /= 10;
+		}
+	}
+	for (size_t j = 0; j < top_len; ++j)
+	{
+		*(--curr) = (char)('0' + top % 10);
+		top /= 10;
+	}
+
+	return str;
+}
+
+int bn_to_string_rec(bn const* Obj, int radix, char* str, size_t width)
+{
+	int power = 0;
+	size_t k = (size_t)bn_radix_chunk(radix, &power);
+
+	if (Obj->size <= BN_TO_STRING_THRESHOLD || width <= 2 * k)
+	{
+		// делим на radix^k, получая по k цифр за проход
+		int* arr = (int*)bn_alloc(Obj->size * sizeof(int));
+		if (arr == NULL)
+		{
+			return BN_NO_MEMORY;
+		}
+		memcpy(arr, Obj->ptr_body, Obj->size * sizeof(int));
+
+		size_t n = Obj->size;
+		size_t pos = width;
+		while (pos > 0)
+		{
+			int curr_mod = 0;
+			if (n == 1 && arr[0] < power)
+			{
+				curr_mod = arr[0];
+				arr[0] = 0;
+			}
+			else
+			{
+				curr_mod = bn_limbs_divrem_1(arr, arr, n, power);
+				while (n > 1 && arr[n - 1] == 0)
+				{
+					--n;
+				}
+			}
+
+			for (size_t i = 0; i < k && pos > 0; ++i)
+			{
+				str[--pos] = int_to_char(curr_mod % radix);
+				curr_mod /= radix;
+			}
+		}
+
+		bn_free(arr);
+		return BN_OK;
+	}
+
+	// наибольший уровень, число цифр которого (k * 2^level) меньше width
+	size_t level = 0;
+	while (level + 1 < BN_RADIX_LEVELS && (k << (level + 1)) < width)
+	{
+		++level;
+	}
+	size_t width_low = k << level;
+
+	bn const* Obj_p = bn_radix_power(radix, level);
+	if (Obj_p == NULL)
+	{
+		return BN_NO_MEMORY;
+	}
+
+	bn* Obj_q = bn_new();
+	bn* Obj_r = bn_new();
+	if (Obj_q == NULL || Obj_r == NULL)
+	{
+		bn_delete(Obj_q);
+		bn_delete(Obj_r);
+		return BN_NO_MEMORY;
+	}
+
+	int res = bn_divrem_abs(Obj_q, Obj_r, Obj, Obj_p);
+	if (res == BN_OK)
+	{
+		res = bn_to_string_rec(Obj_q, radix, str, width - width_low);
+	}
+	if (res == BN_OK)
+	{
+		res = bn_to_string_rec(Obj_r, radix, str + width - width_low, width_low);
+	}
+
+	bn_delete(Obj_q);
+	bn_delete(Obj_r);
+
+	return res;
+}
+
+int bn_init_string_rec(bn* Obj, const char* str, size_t length, int radix)
+{
+	int power = 0;
+	size_t k = (size_t)bn_radix_chunk(radix, &power);
+
+	if (length <= k * BN_FROM_STRING_THRESHOLD)
+	{
+		// схема Горнера по блокам из k цифр: значение блока помещается в одну ячейку
+		size_t n = 0;
+		int* arr = (int*)bn_alloc((length / k + 2) * sizeof(int));
+		if (arr == NULL)
+		{
+			return BN_NO_MEMORY;
+		}
+
+		size_t j = 0;
+		size_t first = length % k == 0 ? k : length % k; // первый блок может быть неполным
+		while (j < length)
+		{
+			size_t end = j + first;
+			long long chunk = 0;
+			long long chunk_power = 1;
+			for (; j < end; ++j)
+			{
+				chunk = chunk * radix + char_to_int(str[j]);
+				chunk_power *= radix;
+			}
+			first = k;
+
+			unsigned long long carry = (unsigned long long)chunk;
+			for (size_t t = 0; t < n; ++t)
+			{
+				unsigned long long curr = (unsigned long long)arr[t] * (unsigned long long)chunk_power + carry;
+				arr[t] = (int)(curr % NOTATION);
+				carry = curr / NOTATION;
+			}
+			while (carry != 0)
+			{
+				arr[n++] = (int)(carry % NOTATION);
+				carry /= NOTATION;
+			}
+		}
+
+		int res = bn_init_limbs(Obj, arr, n);
+		bn_free(arr);
+		return res;
+	}
+
+	// наибольший уровень, число цифр которого (k * 2^level) меньше length
+	size_t level = 0;
+	while (level + 1 < BN_RADIX_LEVELS && (k << (level + 1)) < length)
+	{
+		++level;
+	}
+	size_t length_low = k << level;
+
+	bn const* Obj_p = bn_radix_power(radix, level);
+	if (Obj_p == NULL)
+	{
+		return BN_NO_MEMORY;
+	}
+
+	bn* Obj_low = bn_new();
+	if (Obj_low == NULL)
+	{
+		return BN_NO_MEMORY;
+	}
+
+	// Obj = старшая часть * radix^length_low + младшая часть
+	int res = bn_init_string_rec(Obj, str, length - length_low, radix);
+	if (res == BN_OK)
+	{
+		res = bn_init_string_rec(Obj_low, str + length - length_low, length_low, radix);
+	}
+	if (res == BN_OK)
+	{
+		res = bn_mul_to(Obj, Obj_p);
+	}
+	if (res == BN_OK)
+	{
+		res = bn_add_to(Obj, Obj_low);
+	}
+
+	bn_delete(Obj_low);
+	return res;
+}
+
+int bn_init_limbs(bn* Obj, const int* arr, size_t len)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	len = bn_limbs_normalize(arr, len); // ведущие нули не копируются
+	if (len == 0)
+	{
+		Obj->size = 1;
+		Obj->ptr_body[0] = 0;
+		Obj->sign = 0;
+		return BN_OK;
+	}
+
+	int res_err = bn_grow(Obj, len);
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	memcpy(Obj->ptr_body, arr, len * sizeof(int));
+	Obj->size = len;
+	Obj->sign = 1;
+
+	return BN_OK;
+}
+
+size_t bn_u64_to_limbs(int* arr, unsigned long long num)
+{
+	size_t len = 0;
+	do
+	{
+		arr[len++] = (int)(num % NOTATION);
+		num /= NOTATION;
+	} while (num != 0);
+
+	return len;
+}
+
+int bn_add_u64(bn* Obj, unsigned long long num, int sign)
+{
+	if (sign == 0)
+	{
+		return BN_OK;
+	}
+
+	int b[3];
+	size_t nb = bn_u64_to_limbs(b, num);
+	size_t n = Obj->size;
+
+	if (Obj->sign == 0 || Obj->sign == sign)
+	{
+		// модули складываются
+		int res_err = bn_grow(Obj, (n > nb ? n : nb) + 1);
+		if (res_err != BN_OK)
+		{
+			return res_err;
+		}
+
+		int* a = Obj->ptr_body;
+		int flag = 0;
+		if (n >= nb)
+		{
+			flag = bn_limbs_add(a, a, n, b, nb);
+		}
+		else
+		{
+			flag = bn_limbs_add(a, b, nb, a, n);
+			n = nb;
+		}
+
+		a[n] = flag;
+		Obj->size = n + flag;
+		Obj->sign = sign;
+		return BN_OK;
+	}
+
+	// знаки разные: из большего модуля вычитается меньший
+	int cmp = n != nb ? (n < nb ? -1 : 1) : bn_limbs_cmp(Obj->ptr_body, b, n);
+	if (cmp >= 0)
+	{
+		bn_limbs_sub(Obj->ptr_body, Obj->ptr_body, n, b, nb);
+	}
+	else
+	{
+		int res_err = bn_grow(Obj, nb);
+		if (res_err != BN_OK)
+		{
+			return res_err;
+		}
+
+		bn_limbs_sub(Obj->ptr_body, b, nb, Obj->ptr_body, n);
+		Obj->size = nb;
+		Obj->sign = sign;
+	}
+
+	return Clean_Nulls_Front(Obj);
+}
+
+int bn_mul_u64(bn* Obj, unsigned long long num)
+{
+	if (Obj->sign == 0 || num == 0)
+	{
+		Obj->size = 1;
+		Obj->ptr_body[0] = 0;
+		Obj->sign = 0;
+		return BN_OK;
+	}
+
+	int d[3];
+	size_t nd = bn_u64_to_limbs(d, num);
+	size_t n = Obj->size;
+
+	int res_err = bn_grow(Obj, n + nd);
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	int* a = Obj->ptr_body;
+	if (nd == 1)
+	{
+		a[n] = bn_limbs_mul_1(a, a, n, d[0]);
+	}
+	else
+	{
+		// на месте, от старших ячеек к младшим: a[i] * d добавляется в ячейки i..i + nd,
+		// которые уже не будут прочитаны как множитель
+		memset(a + n, 0, nd * sizeof(int));
+		for (size_t i = n; i-- > 0;)
+		{
+			unsigned long long t = (unsigned int)a[i];
+			a[i] = 0;
+
+			for (size_t j = 0; j < nd; ++j)
+			{
+				unsigned long long carry = t * (unsigned int)d[j];
+				for (size_t k = i + j; carry != 0; ++k)
+				{
+					carry += (unsigned int)a[k];
+					a[k] = (int)(carry % NOTATION);
+					carry /= NOTATION;
+				}
+			}
+		}
+	}
+
+	Obj->size = n + nd;
+
+	return Clean_Nulls_Front(Obj);
+}
+
+int bn_add_signed_into(bn* dst, bn const* Obj1, bn const* Obj2, int negate)
+{
+	// знаки и длины запоминаются до изменения dst, который может совпадать с операндами
+	int sign1 = Obj1->sign;
+	int sign2 = negate ? -Obj2->sign : Obj2->sign;
+	size_t n1 = Obj1->size, n2 = Obj2->size;
+
+	if (sign2 == 0)
+	{
+		return Analog_assignment(dst, Obj1);
+	}
+	if (sign1 == 0)
+	{
+		int res_err = Analog_assignment(dst, Obj2);
+		dst->sign = sign2;
+		return res_err;
+	}
+
+	if (sign1 == sign2)
+	{
+		// |dst| = |Obj1| + |Obj2|, длинное слагаемое идет первым
+		bn const* Obj_l = n1 >= n2 ? Obj1 : Obj2;
+		bn const* Obj_s = n1 >= n2 ? Obj2 : Obj1;
+		size_t n_l = n1 >= n2 ? n1 : n2;
+		size_t n_s = n1 >= n2 ? n2 : n1;
+
+		int res_err = bn_grow(dst, n_l + 1);
+		if (res_err != BN_OK)
+		{
+			return res_err;
+		}
+
+		// указатели на ячейки берутся после bn_grow: он мог перенести ячейки dst
+		int flag = bn_limbs_add(dst->ptr_body, Obj_l->ptr_body, n_l, Obj_s->ptr_body, n_s);
+		dst->ptr_body[n_l] = flag;
+		dst->size = n_l + flag;
+		dst->sign = sign1;
+
+		return BN_OK;
+	}
+
+	// знаки разные: |dst| = |большее| - |меньшее|, знак - у большего по модулю
+	int cmp = bn_abs_cmp(Obj1, Obj2);
+	if (cmp == 0)
+	{
+		dst->size = 1;
+		dst->ptr_body[0] = 0;
+		dst->sign = 0;
+		return BN_OK;
+	}
+
+	bn const* Obj_l = cmp > 0 ? Obj1 : Obj2;
+	bn const* Obj_s = cmp > 0 ? Obj2 : Obj1;
+	size_t n_l = cmp > 0 ? n1 : n2;
+	size_t n_s = cmp > 0 ? n2 : n1;
+
+	int res_err = bn_grow(dst, n_l);
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	bn_limbs_sub(dst->ptr_body, Obj_l->ptr_body, n_l, Obj_s->ptr_body, n_s);
+	dst->size = n_l;
+	dst->sign = cmp > 0 ? sign1 : sign2;
+
+	return Clean_Nulls_Front(dst);
+}
+
+unsigned int* bn_bits30(bn const* Obj, size_t* count)
+{
+	size_t n = Obj->size;
+	unsigned int* words = (unsigned int*)bn_alloc((n + 1) * sizeof(unsigned int)); // 30 * (n + 1) > log2(NOTATION) * n
+	int* arr = (int*)bn_alloc(n * sizeof(int)); // делимое, уменьшающееся при каждом делении
+	if (words == NULL || arr == NULL)
+	{
+		bn_free(words);
+		bn_free(arr);
+		return NULL;
+	}
+
+	memcpy(arr, Obj->ptr_body, n * sizeof(int));
+
+	size_t len = 0;
+	while (n > 0)
+	{
+		words[len++] = (unsigned int)bn_limbs_divrem_1(arr, arr, n, 1 << 30);
+		for (; n > 0 && arr[n - 1] == 0; --n);
+	}
+
+	bn_free(arr);
+	*count = len;
+	return words;
+}
+
+int bn_bits30_get(const unsigned int* words, size_t i)
+{
+	return (int)((words[i / 30] >> (i % 30)) & 1);
+}
+
+int bn_mulmod_step(bn* x, bn const* y, bn_mont_ctx const* mont, bn_barrett const* br, bn* t, bn* t2)
+{
+	int res_err = x == y ? bn_sqr_into(t, x) : bn_mul_into(t, x, y);
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	return mont != NULL ? bn_mont_reduce(x, t, mont) : bn_barrett_reduce_tmp(x, t, br, t2);
+}
+
+int bn_limbs_add_n(int* r, const int* a, const int* b, size_t n)
+{
+	int flag = 0; // перенос
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		int curr = a[i] + b[i] + flag;
+		flag = curr >= (int)NOTATION;
+		r[i] = flag ? curr - (int)NOTATION : curr;
+	}
+
+	return flag;
+}
+
+int bn_limbs_sub_n(int* r, const int* a, const int* b, size_t n)
+{
+	int flag = 0; // заем
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		int curr = a[i] - b[i] - flag;
+		flag = curr < 0;
+		r[i] = flag ? curr + (int)NOTATION : curr;
+	}
+
+	return flag;
+}
+
+int bn_limbs_add_1(int* r, const int* a, size_t n, int d)
+{
+	size_t i = 0;
+	for (; i < n && d != 0; ++i)
+	{
+		int curr = a[i] + d;
+		d = curr >= (int)NOTATION;
+		r[i] = d ? curr - (int)NOTATION : curr;
+	}
+
+	// перенос кончился: остальные ячейки копируются (при r == a - ничего не делается)
+	if (r != a && i < n)
+	{
+		memcpy(r + i, a + i, (n - i) * sizeof(int));
+	}
+
+	return d;
+}
+
+int bn_limbs_sub_1(int* r, const int* a, size_t n, int d)
+{
+	size_t i = 0;
+	for (; i < n && d != 0; ++i)
+	{
+		int curr = a[i] - d;
+		d = curr < 0;
+		r[i] = d ? curr + (int)NOTATION : curr;
+	}
+
+	if (r != a && i < n)
+	{
+		memcpy(r + i, a + i, (n - i) * sizeof(int));
+	}
+
+	return d;
+}
+
+int bn_limbs_add(int* r, const int* a, size_t na, const int* b, size_t nb)
+{
+	int flag = bn_limbs_add_n(r, a, b, nb);
+	return bn_limbs_add_1(r + nb, a + nb, na - nb, flag);
+}
+
+int bn_limbs_sub(int* r, const int* a, size_t na, const int* b, size_t nb)
+{
+	int flag = bn_limbs_sub_n(r, a, b, nb);
+	return bn_limbs_sub_1(r + nb, a + nb, na - nb, flag);
+}
+
+int bn_limbs_add_to(int* r, size_t nr, const int* a, size_t na)
+{
+	int flag = bn_limbs_add_n(r, r, a, na);
+	return bn_limbs_add_1(r + na, r + na, nr - na, flag);
+}
+
+size_t bn_limbs_normalize(const int* a, size_t n)
+{
+	for (; n > 0 && a[n - 1] == 0; --n);
+	return n;
+}
+
+int bn_limbs_div_2(int* a, size_t n)
+{
+	unsigned int curr_mod = 0;
+	for (size_t i = n; i-- > 0;)
+	{
+		unsigned int curr = curr_mod * NOTATION + (unsigned int)a[i]; // < 2 * NOTATION, помещается в 32 бита
+		a[i] = (int)(curr / 2);
+		curr_mod = curr % 2;
+	}
+	return (int)curr_mod;
+}
+
+int bn_limbs_div_3(int* a, size_t n)
+{
+	unsigned int curr_mod = 0;
+	for (size_t i = n; i-- > 0;)
+	{
+		unsigned int curr = curr_mod * NOTATION + (unsigned int)a[i]; // < 3 * NOTATION, помещается в 32 бита
+		a[i] = (int)(curr / 3);
+		curr_mod = curr % 3;
+	}
+	return (int)curr_mod;
+}
+
+void bn_limbs_mul_basecase(int* r, const int* a, size_t na, const int* b, size_t nb)
+{
+	memset(r, 0, (na + nb) * sizeof(int));
+
+	for (size_t i = 0; i < na; ++i)
+	{
+		unsigned long long flag = 0; // перенос
+		unsigned long long ai = (unsigned int)a[i];
+
+		for (size_t j = 0; j < nb; ++j)
+		{
+			unsigned long long curr = (unsigned int)r[i + j] + ai * (unsigned int)b[j] + flag;
+			flag = curr / NOTATION;
+			r[i + j] = (int)(curr - flag * NOTATION);
+		}
+		r[i + nb] = (int)flag;
+	}
+}
+
+void bn_limbs_sqr_basecase(int* r, const int* a, size_t n)
+{
+	memset(r, 0, 2 * n * sizeof(int));
+
+	// сумма попарных произведений a[i] * a[j], i < j
+	for (size_t i = 0; i + 1 < n; ++i)
+	{
+		unsigned long long flag = 0; // перенос
+		unsigned long long ai = (unsigned int)a[i];
+
+		for (size_t j = i + 1; j < n; ++j)
+		{
+			unsigned long long curr = (unsigned int)r[i + j] + ai * (unsigned int)a[j] + flag;
+			flag = curr / NOTATION;
+			r[i + j] = (int)(curr - flag * NOTATION);
+		}
+		r[i + n] = (int)flag;
+	}
+
+	// удвоение и прибавление квадратов a[i] * a[i] на позициях 2i
+	unsigned long long flag = 0;
+	for (size_t i = 0; i < n; ++i)
+	{
+		unsigned long long ai = (unsigned int)a[i];
+
+		unsigned long long curr = 2ULL * (unsigned int)r[2 * i] + ai * ai + flag;
+		flag = curr / NOTATION;
+		r[2 * i] = (int)(curr - flag * NOTATION);
+
+		curr = 2ULL * (unsigned int)r[2 * i + 1] + flag;
+		flag = curr / NOTATION;
+		r[2 * i + 1] = (int)(curr - flag * NOTATION);
+	}
+}
+
+int bn_limbs_cmp(const int* a, const int* b, size_t n)
+{
+	for (size_t i = n; i-- > 0;)
+	{
+		if (a[i] != b[i])
+		{
+			return a[i] > b[i] ? 1 : -1;
+		}
+	}
+	return 0;
+}
+
+int bn_limbs_mul_1(int* r, const int* a, size_t n, int d)
+{
+	unsigned long long flag = 0; // перенос
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		unsigned long long curr = (unsigned long long)(unsigned int)a[i] * (unsigned int)d + flag;
+		flag = curr / NOTATION;
+		r[i] = (int)(curr - flag * NOTATION);
+	}
+
+	return (int)flag;
+}
+
+int bn_limbs_submul_1(int* r, const int* a, size_t n, int d)
+{
+	unsigned long long flag = 0; // заем
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		unsigned long long curr = (unsigned long long)(unsigned int)a[i] * (unsigned int)d + flag;
+		flag = curr / NOTATION;
+
+		int curr_r = r[i] - (int)(curr - flag * NOTATION);
+		int borrow = curr_r < 0;
+		r[i] = borrow ? curr_r + (int)NOTATION : curr_r;
+		flag += borrow;
+	}
+
+	return (int)flag;
+}
+
+int bn_limbs_addmul_1(int* r, const int* a, size_t n, int d)
+{
+	unsigned long long flag = 0; // перенос
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		unsigned long long curr = (unsigned long long)(unsigned int)a[i] * (unsigned int)d + (unsigned int)r[i] + flag;
+		flag = curr / NOTATION;
+		r[i] = (int)(curr - flag * NOTATION);
+	}
+
+	return (int)flag;
+}
+
+void bn_limbs_lehmer(int* a, int* b, size_t n, long long A, long long B, long long C, long long D)
+{
+	// |A * a[i] + B * b[i]| < 2 * NOTATION^2, сумма с переносом помещается в long long
+	const long long base = NOTATION;
+	long long flag_a = 0, flag_b = 0; // переносы (могут быть отрицательными)
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		long long x = a[i], y = b[i];
+		long long curr_a = A * x + B * y + flag_a;
+		long long curr_b = C * x + D * y + flag_b;
+
+		// деление с округлением вниз, чтобы ячейки оставались неотрицательными
+		flag_a = curr_a / base;
+		curr_a -= flag_a * base;
+		if (curr_a < 0)
+		{
+			curr_a += base;
+			--flag_a;
+		}
+		flag_b = curr_b / base;
+		curr_b -= flag_b * base;
+		if (curr_b < 0)
+		{
+			curr_b += base;
+			--flag_b;
+		}
+
+		a[i] = (int)curr_a;
+		b[i] = (int)curr_b;
+	}
+
+	// результаты неотрицательны, последний перенос меньше 2 * NOTATION
+	a[n] = (int)(flag_a % base);
+	a[n + 1] = (int)(flag_a / base);
+	b[n] = (int)(flag_b % base);
+	b[n + 1] = (int)(flag_b / base);
+}
+
+void bn_limbs_redc(int* t, const int* m, size_t n, int m_inv)
+{
+	// по столбцам: в столбце i собираются t[i], перенос и произведения u[j] * m[i - j];
+	// найденные u[j] записываются на место уже обработанных t[j]
+	unsigned long long flag = 0; // перенос в следующий столбец
+
+	for (size_t i = 0; i < 2 * n; ++i)
+	{
+		unsigned long long acc = (unsigned long long)(unsigned int)t[i] + flag % NOTATION; // младшая часть суммы столбца
+		unsigned long long high = flag / NOTATION; // старшая часть суммы столбца (в единицах NOTATION)
+
+		size_t j = i >= n ? i - n + 1 : 0;
+		size_t j_end = i < n ? i : n;
+		while (j < j_end)
+		{
+			// без нормализации складывается не больше BN_REDC_LAZY произведений, меньших NOTATION^2
+			size_t j_stop = j_end - j > BN_REDC_LAZY ? j + BN_REDC_LAZY : j_end;
+			for (; j < j_stop; ++j)
+			{
+				acc += (unsigned long long)(unsigned int)t[j] * (unsigned int)m[i - j];
+			}
+			high += acc / NOTATION;
+			acc %= NOTATION;
+		}
+
+		if (i < n)
+		{
+			// u[i] подбирается так, чтобы столбец делился на NOTATION: acc + u[i] * m[0] = 0 mod NOTATION
+			unsigned long long u = acc * (unsigned int)m_inv % NOTATION;
+			acc += u * (unsigned int)m[0];
+			t[i] = (int)u;
+			flag = high + acc / NOTATION;
+		}
+		else
+		{
+			t[i] = (int)(acc % NOTATION);
+			flag = high + acc / NOTATION;
+		}
+	}
+
+	t[2 * n] = (int)flag; // частное не больше 2m, старшая ячейка - 0 или 1
+}
+
+int bn_limbs_divrem_1(int* q, const int* a, size_t n, int d)
+{
+	unsigned long long curr_mod = 0;
+
+	for (size_t i = n; i-- > 0;)
+	{
+		unsigned long long curr = curr_mod * NOTATION + (unsigned int)a[i];
+		q[i] = (int)(curr / (unsigned int)d);
+		curr_mod = curr - (unsigned long long)q[i] * (unsigned int)d;
+	}
+
+	return (int)curr_mod;
+}
+
+int bn_limbs_divrem(int* q, int* r, const int* a, size_t na, const int* b, size_t nb)
+{
+	if (nb == 1)
+	{
+		int curr_mod = bn_limbs_divrem_1(q, a, na, b[0]);
+		if (r != NULL)
+		{
+			r[0] = curr_mod;
+		}
+		return BN_OK;
+	}
+
+	// деления не слишком длинных чисел обходятся без выделения памяти
+	int un_short[BN_DIV_STACK_LIMBS];
+	int* un = un_short; // нормализованное делимое, na + 1 ячеек
+	if (na + 1 + nb > sizeof(un_short) / sizeof(int))
+	{
+		un = (int*)bn_alloc((na + 1 + nb) * sizeof(int));
+		if (un == NULL)
+		{
+			return BN_NO_MEMORY;
+		}
+	}
+	int* vn = un + na + 1; // нормализованный делитель, nb ячеек
+
+	// нормализация: после умножения на d старшая ячейка делителя не меньше NOTATION / 2
+	int d = (int)(NOTATION / ((unsigned int)b[nb - 1] + 1));
+	un[na] = bn_limbs_mul_1(un, a, na, d);
+	bn_limbs_mul_1(vn, b, nb, d);
+
+	unsigned long long v1 = (unsigned int)vn[nb - 1], v2 = (unsigned int)vn[nb - 2];
+
+	for (size_t j = na - nb + 1; j-- > 0;)
+	{
+		// оценка очередной ячейки частного по двум старшим ячейкам остатка
+		unsigned long long num = (unsigned long long)(unsigned int)un[j + nb] * NOTATION + (unsigned int)un[j + nb - 1];
+		unsigned long long q_hat = num / v1;
+		unsigned long long r_hat = num - q_hat * v1;
+
+		// уточнение по третьей ячейке: после него оценка больше истинной не более чем на 1
+		while (q_hat >= NOTATION || q_hat * v2 > r_hat * NOTATION + (unsigned int)un[j + nb - 2])
+		{
+			--q_hat;
+			r_hat += v1;
+			if (r_hat >= NOTATION)
+			{
+				break;
+			}
+		}
+
+		// вычитание q_hat * vn из текущего остатка
+		int flag = bn_limbs_submul_1(un + j, vn, nb, (int)q_hat);
+		un[j + nb] -= flag;
+
+		if (un[j + nb] < 0) // оценка оказалась на 1 больше: возвращаем делитель
+		{
+			--q_hat;
+			un[j + nb] += bn_limbs_add(un + j, un + j, nb, vn, nb);
+		}
+
+		q[j] = (int)q_hat;
+	}
+
+	if (r != NULL)
+	{
+		bn_limbs_divrem_1(r, un, nb, d); // денормализация остатка
+	}
+
+	if (un != un_short)
+	{
+		bn_free(un);
+	}
+	return BN_OK;
+}
+
+size_t bn_limbs_karatsuba_scratch(size_t n)
+{
+	size_t need = 0;
+	while (n >= BN_KARATSUBA_THRESHOLD)
+	{
+		size_t m = (n + 1) / 2;
+		need += 4 * m + 4;
+		n = m + 1;
+	}
+	return need;
+}
+
+void bn_limbs_mul_karatsuba(int* r, const int* a, size_t na, const int* b, size_t nb, int* tmp)
+{
+	if (na < nb)
+	{
+		const int* t = a; a = b; b = t;
+		size_t n = na; na = nb; nb = n;
+	}
+	if (nb < BN_KARATSUBA_THRESHOLD)
+	{
+		bn_limbs_mul_basecase(r, a, na, b, nb);
+		return;
+	}
+
+	size_t m = (na + 1) / 2; // длина младшей половины: a = a1 * NOTATION^m + a0
+	size_t h = na - m; // длина старшей половины a
+
+	if (nb <= m) // множители несбалансированы: a0 * b и a1 * b считаются отдельно
+	{
+		int* t = tmp; // a1 * b, h + nb ячеек
+		bn_limbs_mul_karatsuba(r, a, m, b, nb, tmp);
+		memset(r + m + nb, 0, h * sizeof(int));
+		bn_limbs_mul_karatsuba(t, a + m, h, b, nb, tmp + h + nb);
+		bn_limbs_add_to(r + m, na + nb - m, t, h + nb);
+		return;
+	}
+
+	size_t hb = nb - m; // длина старшей половины b
+	int* sa = tmp; // a0 + a1, m + 1 ячеек
+	int* sb = tmp + m + 1; // b0 + b1, m + 1 ячеек
+	int* z1 = tmp + 2 * m + 2; // (a0 + a1) * (b0 + b1), 2m + 2 ячеек
+	int* rest = tmp + 4 * m + 4;
+
+	sa[m] = bn_limbs_add(sa, a, m, a + m, h);
+	sb[m] = bn_limbs_add(sb, b, m, b + m, hb);
+
+	bn_limbs_mul_karatsuba(z1, sa, m + 1, sb, m + 1, rest);
+	bn_limbs_mul_karatsuba(r, a, m, b, m, rest); // z0 = a0 * b0
+	bn_limbs_mul_karatsuba(r + 2 * m, a + m, h, b + m, hb, rest); // z2 = a1 * b1
+
+	// z1 = z1 - z0 - z2 = a0 * b1 + a1 * b0
+	bn_limbs_sub(z1, z1, 2 * m + 2, r, 2 * m);
+	bn_limbs_sub(z1, z1, 2 * m + 2, r + 2 * m, h + hb);
+
+	size_t nz = 2 * m + 2;
+	for (; nz > 0 && z1[nz - 1] == 0; --nz);
+	bn_limbs_add_to(r + m, na + nb - m, z1, nz);
+}
+
+void bn_limbs_sqr_karatsuba(int* r, const int* a, size_t n, int* tmp)
+{
+	if (n < BN_SQR_KARATSUBA_THRESHOLD)
+	{
+		bn_limbs_sqr_basecase(r, a, n);
+		return;
+	}
+
+	size_t m = (n + 1) / 2; // длина младшей половины: a = a1 * NOTATION^m + a0
+	size_t h = n - m; // длина старшей половины
+	int* sa = tmp; // a0 + a1, m + 1 ячеек
+	int* z1 = tmp + m + 1; // (a0 + a1)^2, 2m + 2 ячеек
+	int* rest = tmp + 3 * m + 3;
+
+	sa[m] = bn_limbs_add(sa, a, m, a + m, h);
+
+	bn_limbs_sqr_karatsuba(z1, sa, m + 1, rest);
+	bn_limbs_sqr_karatsuba(r, a, m, rest); // z0 = a0^2
+	bn_limbs_sqr_karatsuba(r + 2 * m, a + m, h, rest); // z2 = a1^2
+
+	// z1 = z1 - z0 - z2 = 2 * a0 * a1
+	bn_limbs_sub(z1, z1, 2 * m + 2, r, 2 * m);
+	bn_limbs_sub(z1, z1, 2 * m + 2, r + 2 * m, 2 * h);
+
+	size_t nz = 2 * m + 2;
+	for (; nz > 0 && z1[nz - 1] == 0; --nz);
+	bn_limbs_add_to(r + m, 2 * n - m, z1, nz);
+}
+
+unsigned int bn_ntt_mul(unsigned int a, unsigned int b, unsigned int p, unsigned int p_inv)
+{
+	unsigned long long t = (unsigned long long)a * b;
+	unsigned int m = (unsigned int)t * p_inv;
+	unsigned int u = (unsigned int)((t + (unsigned long long)m * p) >> 32);
+
+	return u >= p ? u - p : u;
+}
+
+unsigned int bn_ntt_pow(unsigned int a, unsigned long long degree, unsigned int p)
+{
+	unsigned long long res = 1, curr = a % p;
+
+	for (; degree != 0; degree >>= 1)
+	{
+		if (degree & 1)
+		{
+			res = res * curr % p;
+		}
+		curr = curr * curr % p;
+	}
+
+	return (unsigned int)res;
+}
+
+void bn_ntt(unsigned int* a, size_t n, const unsigned int* rt, unsigned int p, unsigned int p_inv)
+{
+	// перестановка элементов в бит-реверсивном порядке
+	for (size_t i = 1, j = 0; i < n; ++i)
+	{
+		size_t bit = n >> 1;
+		for (; j & bit; bit >>= 1)
+		{
+			j ^= bit;
+		}
+		j ^= bit;
+
+		if (i < j)
+		{
+			unsigned int t = a[i];
+			a[i] = a[j];
+			a[j] = t;
+		}
+	}
+
+	// бабочки Кули-Тьюки; rt[h + j] - корень степени 2h в степени j (в форме Монтгомери)
+	for (size_t h = 1; h < n; h <<= 1)
+	{
+		for (size_t i = 0; i < n; i += 2 * h)
+		{
+			for (size_t j = 0; j < h; ++j)
+			{
+				unsigned int u = a[i + j];
+				unsigned int v = bn_ntt_mul(a[i + j + h], rt[h + j], p, p_inv);
+
+				a[i + j] = u + v >= p ? u + v - p : u + v;
+				a[i + j + h] = u >= v ? u - v : u + p - v;
+			}
+		}
+	}
+}
+
+int bn_limbs_mul_ntt(int* r, const int* a, size_t na, const int* b, size_t nb)
+{
+	size_t n_r = na + nb; // длина произведения
+	size_t n = 1; // длина преобразования
+	while (n < n_r)
+	{
+		n <<= 1;
+	}
+
+	bool sqr = a == b && na == nb; // квадрат: образ второго множителя совпадает с первым
+
+	unsigned int* fa = (unsigned int*)bn_alloc(n * sizeof(unsigned int)); // образ первого множителя
+	unsigned int* fb = sqr ? fa : (unsigned int*)bn_alloc(n * sizeof(unsigned int)); // образ второго множителя
+	unsigned int* rt = (unsigned int*)bn_alloc(n * sizeof(unsigned int)); // таблица корней
+	unsigned int* res = (unsigned int*)bn_alloc(3 * n_r * sizeof(unsigned int)); // вычеты свертки по каждому модулю
+
+	if (fa == NULL || fb == NULL || rt == NULL || res == NULL)
+	{
+		bn_free(fa);
+		if (!sqr)
+		{
+			bn_free(fb);
+		}
+		bn_free(rt);
+		bn_free(res);
+		return BN_NO_MEMORY;
+	}
+
+	for (int k = 0; k < 3; ++k)
+	{
+		unsigned int p = BN_NTT_PRIMES[k];
+
+		unsigned int p_inv = p; // -p^(-1) mod 2^32 методом Ньютона
+		for (int i = 0; i < 5; ++i)
+		{
+			p_inv *= 2 - p * p_inv;
+		}
+		p_inv = 0u - p_inv;
+
+		unsigned int mont_one = (unsigned int)(((unsigned long long)1 << 32) % p); // 1 в форме Монтгомери
+		for (size_t h = 1; h < n; h <<= 1)
+		{
+			unsigned int w = bn_ntt_pow(3, (p - 1) / (2 * h), p);
+			unsigned int w_mont = (unsigned int)(((unsigned long long)w << 32) % p);
+
+			rt[h] = mont_one;
+			for (size_t j = 1; j < h; ++j)
+			{
+				rt[h + j] = bn_ntt_mul(rt[h + j - 1], w_mont, p, p_inv);
+			}
+		}
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			fa[i] = i < na ? (unsigned int)a[i] % p : 0;
+		}
+		bn_ntt(fa, n, rt, p, p_inv);
+
+		if (!sqr)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				fb[i] = i < nb ? (unsigned int)b[i] % p : 0;
+			}
+			bn_ntt(fb, n, rt, p, p_inv);
+		}
+
+		// поточечное произведение дает a * b * R^(-1), множитель R^2 / n снимает и его, и нормировку
+		unsigned int scale = bn_ntt_pow(n % p, p - 2, p);
+		scale = (unsigned int)(((unsigned long long)scale << 32) % p);
+		scale = (unsigned int)(((unsigned long long)scale << 32) % p);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			fa[i] = bn_ntt_mul(fa[i], fb[i], p, p_inv);
+		}
+
+		// обратное преобразование - прямое с обращением порядка элементов 1..n-1
+		bn_ntt(fa, n, rt, p, p_inv);
+		for (size_t i = 0; i < n_r; ++i)
+		{
+			unsigned int v = fa[i == 0 ? 0 : n - i];
+			res[k * n_r + i] = bn_ntt_mul(v, scale, p, p_inv);
+		}
+	}
+
+	bn_free(fa);
+	if (!sqr)
+	{
+		bn_free(fb);
+	}
+	bn_free(rt);
+
+	// восстановление по КТО (алгоритм Гарнера): x = x1 + p1 * x2 + p1 * p2 * x3
+	unsigned long long p1 = BN_NTT_PRIMES[0], p2 = BN_NTT_PRIMES[1], p3 = BN_NTT_PRIMES[2];
+	unsigned long long inv_p1 = bn_ntt_pow((unsigned int)(p1 % p2), p2 - 2, (unsigned int)p2); // p1^(-1) mod p2
+	unsigned long long inv_p12 = bn_ntt_pow((unsigned int)(p1 * p2 % p3), p3 - 2, (unsigned int)p3); // (p1 * p2)^(-1) mod p3
+	unsigned long long p12_low = p1 * p2 % NOTATION, p12_high = p1 * p2 / NOTATION; // p1 * p2 в системе NOTATION
+	unsigned long long flag = 0; // перенос в следующую ячейку
+
+	for (size_t i = 0; i < n_r; ++i)
+	{
+		unsigned long long x1 = res[i];
+		unsigned long long x2 = (res[n_r + i] + p2 - x1 % p2) % p2 * inv_p1 % p2;
+		unsigned long long x12 = x1 + p1 * x2; // < p1 * p2
+		unsigned long long x3 = (res[2 * n_r + i] + p3 - x12 % p3) % p3 * inv_p12 % p3;
+
+		unsigned long long curr = flag + x12 + x3 * p12_low;
+		r[i] = (int)(curr % NOTATION);
+		flag = curr / NOTATION + x3 * p12_high;
+	}
+
+	bn_free(res);
+	return BN_OK;
+}
+
+bn* bn_pow(bn const* Obj, int degree)
+{
+	if (Obj == NULL)
+	{
+		return NULL;
+	}
+
+	bn* Obj_r = bn_init(Obj);
+
+	int code = bn_pow_to(Obj_r, degree);
+	if (code != BN_OK)
+	{
+		return NULL;
+	}
+
+	return Obj_r;
+}
+
+int bn_add_nulls_begin(bn* Obj, size_t newsize)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (Obj->size > newsize)
+	{
+		return BN_NO_MEMORY;
+	}
+	if (Obj->size == newsize)
+	{
+		return BN_OK;
+	}
+
+	int res_err = bn_grow(Obj, newsize);
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	memset(Obj->ptr_body + Obj->size, 0, (newsize - Obj->size) * sizeof(int));
+
+	Obj->size = newsize;
+	return BN_OK;
+}
+
+int bn_grow(bn* Obj, size_t newcap)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+	if (Obj->capacity >= newcap)
+	{
+		return BN_OK;
+	}
+
+	// рост в полтора раза, чтобы серия добавлений по одной ячейке стоила O(1) в среднем
+	size_t cap = Obj->capacity + Obj->capacity / 2;
+	if (cap < newcap)
+	{
+		cap = newcap;
+	}
+
+	return bn_reserve(Obj, cap);
+}
+
+int bn_swap(bn* Obj1, bn* Obj2)
+{
+	if (Obj1->ctx == Obj2->ctx)
+	{
+		bn tmp = *Obj1;
+		*Obj1 = *Obj2;
+		*Obj2 = tmp;
+
+		// встроенные ячейки скопировались вместе со структурой, указатели на них переставляются
+		if (Obj1->ptr_body == Obj2->body_inline)
+		{
+			Obj1->ptr_body = Obj1->body_inline;
+		}
+		if (Obj2->ptr_body == Obj1->body_inline)
+		{
+			Obj2->ptr_body = Obj2->body_inline;
+		}
+		return BN_OK;
+	}
+
+	// память разных владельцев не переходит между объектами: значения обмениваются поячеечно
+	size_t n = Obj1->size > Obj2->size ? Obj1->size : Obj2->size;
+	int res_err = bn_grow(Obj1, n);
+	if (res_err == BN_OK)
+	{
+		res_err = bn_grow(Obj2, n);
+	}
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		int tmp = Obj1->ptr_body[i];
+		Obj1->ptr_body[i] = Obj2->ptr_body[i];
+		Obj2->ptr_body[i] = tmp;
+	}
+
+	size_t size = Obj1->size;
+	Obj1->size = Obj2->size;
+	Obj2->size = size;
+
+	int sign = Obj1->sign;
+	Obj1->sign = Obj2->sign;
+	Obj2->sign = sign;
+
+	return BN_OK;
+}
+
+int Clean_Nulls_Front(bn* Obj)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	size_t len = bn_limbs_normalize(Obj->ptr_body, Obj->size);
+	if (len == 0)
+	{
+		Obj->ptr_body[0] = 0;
+		Obj->size = 1;
+		Obj->sign = 0;
+
+		return BN_OK;
+	}
+
+	Obj->size = len;
+
+	// память возвращается лениво: только если число стало заметно короче буфера
+	if (Obj->ctx == NULL && Obj->capacity > BN_SHRINK_MIN && Obj->capacity / BN_SHRINK_FACTOR > Obj->size)
+	{
+		size_t cap = 2 * Obj->size;
+		int* arr = (int*)realloc(Obj->ptr_body, cap * sizeof(int));
+		if (arr != NULL)
+		{
+			Obj->ptr_body = arr;
+			Obj->capacity = cap;
+		}
+	}
+
+	return BN_OK;
+}
+
+int bn_abs_cmp(bn const* Obj1, bn const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	if (Obj1->size != Obj2->size)
+	{
+		return Obj1->size > Obj2->size ? 1 : -1;
+	}
+
+	// размеры равны
+	return bn_limbs_cmp(Obj1->ptr_body, Obj2->ptr_body, Obj1->size);
+}
+
+int bn_fib_pair(bn* Obj_a, bn* Obj_b, unsigned long long num)
+{
+	// (F(k - 1), F(k)) от k = 1 по битам num от старших к младшим:
+	// F(2k - 1) = F(k)^2 + F(k - 1)^2, F(2k + 1) = 4F(k)^2 - F(k - 1)^2 + 2(-1)^k, F(2k) = F(2k + 1) - F(2k - 1)
+	int res_err = bn_init_int(Obj_a, 0);
+	if (res_err == BN_OK) res_err = bn_init_int(Obj_b, 1);
+
+	int bit = 63;
+	for (; bit > 0 && !((num >> bit) & 1); --bit);
+
+	bn* Obj_s = bn_new(); // F(k - 1)^2, затем F(2k - 1)
+	if (Obj_s == NULL)
+	{
+		return BN_NO_MEMORY;
+	}
+
+	int sign = -1; // (-1)^k, k = 1
+	while (res_err == BN_OK && bit-- > 0)
+	{
+		res_err = bn_sqr_into(Obj_s, Obj_a);
+		if (res_err == BN_OK) res_err = bn_sqr_to(Obj_b);
+
+		// Obj_a = F(2k - 1), Obj_b = F(2k + 1)
+		if (res_err == BN_OK) res_err = bn_add_into(Obj_a, Obj_b, Obj_s);
+		if (res_err == BN_OK) res_err = bn_mul_si(Obj_b, 4);
+		if (res_err == BN_OK) res_err = bn_sub_to(Obj_b, Obj_s);
+		if (res_err == BN_OK) res_err = bn_add_si(Obj_b, 2 * sign);
+
+		if (res_err == BN_OK && ((num >> bit) & 1))
+		{
+			// k = 2k + 1: (F(2k), F(2k + 1)), F(2k) = F(2k + 1) - F(2k - 1)
+			res_err = bn_sub_into(Obj_a, Obj_b, Obj_a);
+			sign = -1;
+		}
+		else if (res_err == BN_OK)
+		{
+			// k = 2k: (F(2k - 1), F(2k))
+			res_err = bn_sub_into(Obj_b, Obj_b, Obj_a);
+			sign = 1;
+		}
+	}
+
+	bn_delete(Obj_s);
+	return res_err;
+}
+
+int PrintFibo(int num)
+{
+	if (num < 1)
+	{
+		return BN_INVALID_ARGUMENT;
+	}
+
+	bn* Obj = bn_new();
+	if (Obj == NULL)
+	{
+		return BN_NO_MEMORY;
+	}
+
+	int res_err = bn_fib(Obj, num);
+	if (res_err != BN_OK)
+	{
+		bn_delete(Obj);
+		return res_err;
+	}
+
+	// число переводится в строку целиком и выводится одним вызовом
+	char* str = bn_to_string(Obj, 10);
+	bn_delete(Obj);
+	if (str == NULL)
+	{
+		return BN_NO_MEMORY;
+	}
+
+	fputs(str, stdout);
+	free(str);
+
+	return BN_OK;
+}
+
+int bn_prod_tree(bn* Obj, const unsigned long long* arr, unsigned long long lo, unsigned long long step, size_t count)
+{
+	if (count > BN_PROD_LEAF)
+	{
+		// половины перемножаются отдельно: большие умножения идут с множителями близкой длины
+		size_t half = count / 2;
+
+		bn* Obj_t = bn_new();
+		if (Obj_t == NULL)
+		{
+			return BN_NO_MEMORY;
+		}
+
+		int res_err = bn_prod_tree(Obj, arr, lo, step, half);
+		if (res_err == BN_OK) res_err = bn_prod_tree(Obj_t, arr == NULL ? NULL : arr + half, lo + half * step, step, count - half);
+		if (res_err == BN_OK) res_err = bn_mul_to(Obj, Obj_t);
+
+		bn_delete(Obj_t);
+		return res_err;
+	}
+
+	// несколько множителей подряд, пока их произведение меньше NOTATION, умножаются как одна ячейка
+	int res_err = bn_init_int(Obj, 1);
+	unsigned long long word = 1;
+	for (size_t i = 0; res_err == BN_OK && i < count; ++i)
+	{
+		unsigned long long f = arr != NULL ? arr[i] : lo + i * step;
+		if (word <= (NOTATION - 1) / f)
+		{
+			word *= f;
+			continue;
+		}
+
+		res_err = bn_mul_u64(Obj, word);
+		word = f;
+	}
+	if (res_err == BN_OK) res_err = bn_mul_u64(Obj, word);
+
+	return res_err;
+}
+
+unsigned long long* bn_primes(unsigned long long n, size_t* count)
+{
+	// решето только по нечетным: sieve[i] относится к числу 2i + 1 <= n
+	size_t len = (size_t)(n / 2 + n % 2);
+	char* sieve = (char*)bn_alloc(len + 1);
+	if (sieve == NULL)
+	{
+		return NULL;
+	}
+
+	memset(sieve, 1, len);
+	sieve[0] = 0;
+
+	size_t total = n >= 2;
+	for (size_t i = 1; i < len; ++i)
+	{
+		if (!sieve[i])
+		{
+			continue;
+		}
+
+		++total;
+		unsigned long long p = 2 * (unsigned long long)i + 1;
+		if (p > n / p)
+		{
+			continue;
+		}
+		for (unsigned long long j = p * p / 2; j < len; j += p)
+		{
+			sieve[j] = 0;
+		}
+	}
+
+	unsigned long long* primes = (unsigned long long*)bn_alloc((total + 1) * sizeof(unsigned long long));
+	if (primes != NULL)
+	{
+		size_t k = 0;
+		if (n >= 2)
+		{
+			primes[k++] = 2;
+		}
+		for (size_t i = 1; i < len; ++i)
+		{
+			if (sieve[i])
+			{
+				primes[k++] = 2 * (unsigned long long)i + 1;
+			}
+		}
+		*count = k;
+	}
+
+	bn_free(sieve);
+	return primes;
+}
+
+int bn_binomial_abs(bn* Obj, unsigned long long n, unsigned long long k)
+{
+	if (k > n - k)
+	{
+		k = n - k;
+	}
+	if (k == 0)
+	{
+		return bn_init_int(Obj, 1);
+	}
+
+	if (n / BN_BINOMIAL_SIEVE_RATIO > k)
+	{
+		// k мало по сравнению с n: C(n, k) = (n - k + 1) * ... * n / k!, деление точное
+		bn* Obj_f = bn_new();
+		int res_err = Obj_f == NULL ? BN_NO_MEMORY : bn_prod_tree(Obj, NULL, n - k + 1, 1, (size_t)k);
+		if (res_err == BN_OK) res_err = bn_fac(Obj_f, (long long)k);
+		if (res_err == BN_OK) res_err = bn_div_to(Obj, Obj_f);
+
+		bn_delete(Obj_f);
+		return res_err;
+	}
+
+	// по формуле Лежандра степень простого p в C(n, k) - сумма floor(n / p^i) - floor(k / p^i) - floor((n - k) / p^i);
+	// p^e не превосходит n, множители p^e записываются на место простых
+	size_t count = 0;
+	unsigned long long* primes = bn_primes(n, &count);
+	if (primes == NULL)
+	{
+		return BN_NO_MEMORY;
+	}
+
+	size_t len = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		unsigned long long p = primes[i];
+		unsigned long long f = 1;
+		for (unsigned long long pp = p;; pp *= p)
+		{
+			if (n / pp - k / pp - (n - k) / pp != 0)
+			{
+				f *= p;
+			}
+			if (pp > n / p)
+			{
+				break;
+			}
+		}
+
+		if (f > 1)
+		{
+			primes[len++] = f;
+		}
+	}
+
+	int res_err = bn_prod_tree(Obj, primes, 0, 0, len);
+	bn_free(primes);
+
+	return res_err;
+}
+
+int bn_sqrtrem_abs(bn* s, bn* r, bn const* x)
+{
+	size_t n = x->size;
+	int res_err = BN_OK;
+
+	if (x->sign == 0)
+	{
+		res_err = bn_init_int(s, 0);
+		if (res_err == BN_OK) res_err = bn_init_int(r, 0);
+		return res_err;
+	}
+
+	if (n <= BN_SQRT_BASE_LIMBS)
+	{
+		// приближение сверху по double, затем s = (s + x / s) / 2, пока s убывает (остановка ровно на корне)
+		double d = 0;
+		for (size_t i = n; i-- > 0;)
+		{
+			d = d * NOTATION + (unsigned int)x->ptr_body[i];
+		}
+
+		res_err = bn_init_uint64(s, (unsigned long long)(sqrt(d) * (1 + 1e-9)) + 1);
+		while (res_err == BN_OK)
+		{
+			res_err = bn_divmod(r, NULL, x, s);
+			if (res_err == BN_OK) res_err = bn_add_to(r, s);
+			if (res_err == BN_OK) res_err = bn_divmod_si(r, NULL, r, 2);
+			if (res_err != BN_OK || bn_cmp(r, s) >= 0)
+			{
+				break;
+			}
+			res_err = bn_swap(s, r);
+		}
+	}
+	else
+	{
+		// корень старших n - 2k ячеек дает приближение сверху (s_hi + 1) * NOTATION^k с относительной
+		// ошибкой не больше 1 / s_hi; при k <= (n - 1) / 4 один шаг Ньютона оставляет ошибку в несколько единиц
+		size_t k = (n - 1) / 4;
+
+		bn Obj_hi = *x; // floor(x / NOTATION^(2k))
+		Obj_hi.ptr_body += 2 * k;
+		Obj_hi.size -= 2 * k;
+
+		bn Obj_xk = *x; // floor(x / NOTATION^k)
+		Obj_xk.ptr_body += k;
+		Obj_xk.size -= k;
+
+		res_err = bn_sqrtrem_abs(s, r, &Obj_hi);
+		if (res_err == BN_OK) res_err = bn_add_si(s, 1);
+
+		// s = (s0 + x / s0) / 2, s0 = s * NOTATION^k, x / s0 = floor(x / NOTATION^k) / s
+		if (res_err == BN_OK) res_err = bn_divmod(r, NULL, &Obj_xk, s);
+		if (res_err == BN_OK) res_err = bn_shift_limbs(s, (long)k);
+		if (res_err == BN_OK) res_err = bn_add_to(s, r);
+		if (res_err == BN_OK) res_err = bn_divmod_si(s, NULL, s, 2);
+	}
+
+	// r = x - s^2; шаг Ньютона от приближения сверху не дает значения меньше корня, поэтому s только уменьшается
+	if (res_err == BN_OK) res_err = bn_sqr_into(r, s);
+	if (res_err == BN_OK) res_err = bn_sub_into(r, x, r);
+
+	while (res_err == BN_OK && r->sign < 0)
+	{
+		// (s - 1)^2 = s^2 - 2s + 1
+		res_err = bn_add_to(r, s);
+		if (res_err == BN_OK) res_err = bn_sub_si(s, 1);
+		if (res_err == BN_OK) res_err = bn_add_to(r, s);
+	}
+
+	return res_err;
+}
+
+int bn_init_double(bn* Obj, double num)
+{
+	int arr[40]; // 1e308 < NOTATION^35
+	size_t n = 0;
+
+	num = floor(num);
+	do
+	{
+		double high = floor(num / NOTATION);
+		arr[n++] = (int)(num - high * NOTATION);
+		num = high;
+	} while (num >= 1 && n < 40);
+
+	for (; n > 1 && arr[n - 1] == 0; --n);
+	return bn_init_limbs(Obj, arr, n);
+}
+
+int bn_rootrem_abs(bn* s, bn* r, bn const* x, int k)
+{
+	if (k == 2)
+	{
+		return bn_sqrtrem_abs(s, r, x);
+	}
+	if (x->sign == 0 || k == 1)
+	{
+		int res_err = Analog_assignment(s, x);
+		if (res_err == BN_OK) res_err = bn_init_int(r, 0);
+		return res_err;
+	}
+
+	size_t n = x->size;
+	size_t L = (n - 1) / k; // корень не меньше NOTATION^L
+
+	bn* t = bn_new(); // временное значение
+	int res_err = t == NULL ? BN_NO_MEMORY : BN_OK;
+
+	if (res_err == BN_OK && L < BN_ROOT_BASE_LIMBS)
+	{
+		// ln x по трем старшим ячейкам и длине, приближение корня - exp(ln x / k)
+		size_t top = n < 3 ? n : 3;
+		double d = 0;
+		for (size_t i = n; i-- > n - top;)
+		{
+			d = d * NOTATION + (unsigned int)x->ptr_body[i];
+		}
+		double log_x = log(d) + (double)(n - top) * log((double)NOTATION);
+
+		if (k * log(2.0) > log_x + 1)
+		{
+			res_err = bn_init_int(s, 1); // x < 2^k
+		}
+		else
+		{
+			// приближение сверху (погрешность double много меньше запаса), затем шаги Ньютона
+			// s = ((k - 1) * s + x / s^(k - 1)) / k, пока s убывает (остановка ровно на корне)
+			res_err = bn_init_double(s, exp(log_x / k) * (1 + 1e-12) + 1);
+			while (res_err == BN_OK)
+			{
+				res_err = Analog_assignment(r, s);
+				if (res_err == BN_OK) res_err = bn_pow_to(r, k - 1);
+				if (res_err == BN_OK) res_err = bn_divmod(r, NULL, x, r);
+				if (res_err == BN_OK) res_err = Analog_assignment(t, s);
+				if (res_err == BN_OK) res_err = bn_mul_si(t, k - 1);
+				if (res_err == BN_OK) res_err = bn_add_to(t, r);
+				if (res_err == BN_OK) res_err = bn_divmod_si(t, NULL, t, k);
+				if (res_err != BN_OK || bn_cmp(t, s) >= 0)
+				{
+					break;
+				}
+				res_err = bn_swap(s, t);
 			}
+		}
+	}
+	else if (res_err == BN_OK)
+	{
+		// корень старших n - kj ячеек дает приближение сверху s0 = (s_hi + 1) * NOTATION^j с относительной
+		// ошибкой не больше NOTATION^(j - L); при 2j < L шаг Ньютона оставляет ошибку меньше (k - 1) / (2 * NOTATION)
+		size_t j = (L - 1) / 2;
+
+		bn Obj_hi = *x; // floor(x / NOTATION^(kj))
+		Obj_hi.ptr_body += k * j;
+		Obj_hi.size -= k * j;
+
+		bn Obj_xj = *x; // floor(x / NOTATION^((k - 1)j))
+		Obj_xj.ptr_body += (k - 1) * j;
+		Obj_xj.size -= (k - 1) * j;
+
+		res_err = bn_rootrem_abs(s, r, &Obj_hi, k);
+		if (res_err == BN_OK) res_err = bn_add_si(s, 1);
+
+		// s = ((k - 1) * s0 + x / s0^(k - 1)) / k, x / s0^(k - 1) = floor(x / NOTATION^((k - 1)j)) / s^(k - 1)
+		if (res_err == BN_OK) res_err = Analog_assignment(t, s);
+		if (res_err == BN_OK) res_err = bn_pow_to(t, k - 1);
+		if (res_err == BN_OK) res_err = bn_divmod(r, NULL, &Obj_xj, t);
+		if (res_err == BN_OK) res_err = bn_shift_limbs(s, (long)j);
+		if (res_err == BN_OK) res_err = bn_mul_si(s, k - 1);
+		if (res_err == BN_OK) res_err = bn_add_to(s, r);
+		if (res_err == BN_OK) res_err = bn_divmod_si(s, NULL, s, k);
+	}
+
+	// r = x - s^k; шаг Ньютона от приближения сверху не дает значения меньше корня, поэтому s только уменьшается
+	for (;;)
+	{
+		if (res_err == BN_OK) res_err = Analog_assignment(r, s);
+		if (res_err == BN_OK) res_err = bn_pow_to(r, k);
+		if (res_err == BN_OK) res_err = bn_sub_into(r, x, r);
+		if (res_err != BN_OK || r->sign >= 0)
+		{
+			break;
+		}
+		res_err = bn_sub_si(s, 1);
+	}
+
+	bn_delete(t);
+	return res_err;
+}
+
+bn* bn_sqrt(bn const* Obj)
+{
+	if (Obj == NULL)
+	{
+		return NULL;
+	}
+	if (Obj->sign < 0)
+	{
+		return NULL;
+	}
+
+	bn* Obj_r = bn_new();
+	if (Obj_r == NULL)
+	{
+		return NULL;
+	}
+
+	int res_err = bn_sqrtrem(Obj_r, NULL, Obj);
+	if (res_err != BN_OK)
+	{
+		bn_delete(Obj_r);
+		return NULL;
+	}
+
+	return Obj_r;
+}
+
+int bn_print(bn const* Obj)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	printf("-----------------------------------------------------------\n");
+	printf("Sign = %d\nLength = %ld\nAbsolute value = ", Obj->sign, Obj->size);
+
+	char* str = bn_to_string(Obj, 10);
+	if (str == NULL)
+	{
+		return BN_NO_MEMORY;
+	}
+	printf("%s", str);
+	free(str);
+
+	printf("\n-----------------------------------------------------------\n");
+
+	return BN_OK;
+}
+
+int bn_print_ASM(bn const* Obj)
+{
+	if (Obj == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	printf("-----------------------------------------------------------\n");
+	printf("Sign = %d\nLength = %ld\nAbsolute value = ", Obj->sign, Obj->size);
+
+	for (int i = 0; i != Obj->size; ++i) {
+		printf(" \\ %d \\ ", Obj->ptr_body[i]);
+	}
+	printf("\n-----------------------------------------------------------\n");
+
+	return BN_OK;
+}
+
+char* GetStr()
+{
+	int size = 0;
+	int capacity = 50;
+
+	char* str = (char*)malloc(capacity * sizeof(char));
+	char c = getchar();
+	if (c == '\n')
+	{
+		c = getchar();
+	}
+
+	while (c != '\n')
+	{
+		str[size++] = c;
+
+		if (size >= capacity)
+		{
+			capacity *= 2;
+			str = (char*)realloc(str, capacity * sizeof(char));
+		}
+
+		c = getchar();
+	}
+	str = (char*)realloc(str, (size + 1) * sizeof(char));
+	str[size] = '\0';
+
+	return str;
+}
+
+// ------------------------------------------ УМНОЖЕНИЕ ПО МОНТГОМЕРИ -------------------------------------------------
+
+/* Определения контекста Монтгомери: R = NOTATION^n, n - длина модуля. После создания контекст
+   не изменяется (временные числа операций - у вызывающего), поэтому его могут разделять потоки */
+struct bn_mont_ctx_s {
+	bn* mod; // модуль m (положительный, взаимно простой с NOTATION)
+	bn* r2; // R^2 mod m - для перевода в форму Монтгомери
+	size_t n; // длина модуля в ячейках
+	int m_inv; // -m^(-1) mod NOTATION
+};
+
+/* Конструктор контекста Монтгомери */
+bn_mont_ctx* bn_mont_ctx_new(bn const* Obj_m)
+{
+	// приведение делит на NOTATION = 2^9 * 5^9, поэтому модуль не должен делиться на 2 и на 5
+	if (Obj_m == NULL || Obj_m->sign <= 0 || Obj_m->ptr_body[0] % 2 == 0 || Obj_m->ptr_body[0] % 5 == 0)
+	{
+		return NULL;
+	}
+
+	bn_mont_ctx* mont = (bn_mont_ctx*)malloc(sizeof(bn_mont_ctx));
+	if (mont == NULL)
+	{
+		return NULL;
+	}
+
+	// mod и r2 живут дольше операции, поэтому создаются в куче даже при текущем контексте
+	mont->n = Obj_m->size;
+	bn_ctx* prev = bn_ctx_enter(NULL);
+	mont->mod = bn_init(Obj_m);
+	mont->r2 = bn_new();
+	bn_ctx_leave(prev);
+
+	// m^(-1) mod NOTATION расширенным алгоритмом Евклида
+	long long a = Obj_m->ptr_body[0], b = NOTATION, x = 1, y = 0;
+	while (b != 0)
+	{
+		long long q = a / b, t = a - q * b;
+		a = b;
+		b = t;
+		t = x - q * y;
+		x = y;
+		y = t;
+	}
+	x %= (long long)NOTATION;
+	mont->m_inv = (int)(x > 0 ? NOTATION - x : -x);
+
+	bn Obj_t; // R^2
+	bn_init_local(&Obj_t, bn_ctx_current);
+
+	int res_err = (mont->mod == NULL || mont->r2 == NULL) ? BN_NO_MEMORY : BN_OK;
+	if (res_err == BN_OK)
+	{
+		res_err = bn_init_int(&Obj_t, 1);
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = bn_shift_limbs(&Obj_t, (long)(2 * mont->n));
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = bn_divmod(NULL, mont->r2, &Obj_t, mont->mod);
+	}
+	bn_clear_local(&Obj_t);
+	if (res_err != BN_OK)
+	{
+		bn_mont_ctx_delete(mont);
+		return NULL;
+	}
+
+	return mont;
+}
+
+/* Деструктор контекста Монтгомери */
+int bn_mont_ctx_delete(bn_mont_ctx* mont)
+{
+	if (mont == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	bn_delete(mont->mod);
+	bn_delete(mont->r2);
+	free(mont);
+
+	return BN_OK;
+}
+
+/* Функция для приведения по Монтгомери: dst = t * R^(-1) mod m, t < m * R (t портится) */
+int bn_mont_reduce(bn* dst, bn* t, bn_mont_ctx const* mont)
+{
+	size_t n = mont->n;
+
+	int res_err = bn_grow(t, 2 * n + 1);
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+	memset(t->ptr_body + t->size, 0, (2 * n + 1 - t->size) * sizeof(int));
+
+	bn_limbs_redc(t->ptr_body, mont->mod->ptr_body, n, mont->m_inv);
+
+	// результат в t[n..2n] меньше 2m: при необходимости m вычитается один раз
+	int* res = t->ptr_body + n;
+	if (res[n] != 0 || bn_limbs_cmp(res, mont->mod->ptr_body, n) >= 0)
+	{
+		bn_limbs_sub(res, res, n + 1, mont->mod->ptr_body, n);
+	}
+
+	res_err = bn_grow(dst, n);
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	memcpy(dst->ptr_body, res, n * sizeof(int));
+	dst->size = n;
+	dst->sign = 1;
+
+	return Clean_Nulls_Front(dst);
+}
+
+/* Функция для перевода в форму Монтгомери: dst = a * R mod m */
+int bn_mont_to(bn* dst, bn const* Obj, bn_mont_ctx const* mont)
+{
+	if (dst == NULL || Obj == NULL || mont == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	// сначала a приводится в [0, m), затем a * R^2 * R^(-1) = a * R
+	int res_err = bn_divmod(NULL, dst, Obj, mont->mod);
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	return bn_mont_mul(dst, dst, mont->r2, mont);
+}
+
+/* Функция для перевода из формы Монтгомери: dst = a * R^(-1) mod m */
+int bn_mont_from(bn* dst, bn const* Obj, bn_mont_ctx const* mont)
+{
+	if (dst == NULL || Obj == NULL || mont == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	// приводимое значение портится: оно копируется во временный BN на стеке
+	bn Obj_t;
+	bn_init_local(&Obj_t, bn_ctx_current);
+
+	int res_err = Analog_assignment(&Obj_t, Obj);
+	if (res_err == BN_OK)
+	{
+		res_err = bn_mont_reduce(dst, &Obj_t, mont);
+	}
+
+	bn_clear_local(&Obj_t);
+	return res_err;
+}
+
+/* Функция для умножения в форме Монтгомери: dst = a * b * R^(-1) mod m */
+int bn_mont_mul(bn* dst, bn const* Obj1, bn const* Obj2, bn_mont_ctx const* mont)
+{
+	if (dst == NULL || Obj1 == NULL || Obj2 == NULL || mont == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	bn Obj_t; // произведение до приведения
+	bn_init_local(&Obj_t, bn_ctx_current);
+
+	int res_err = bn_mul_into(&Obj_t, Obj1, Obj2);
+	if (res_err == BN_OK)
+	{
+		res_err = bn_mont_reduce(dst, &Obj_t, mont);
+	}
+
+	bn_clear_local(&Obj_t);
+	return res_err;
+}
+
+/* Функция для возведения в квадрат в форме Монтгомери: dst = a * a * R^(-1) mod m */
+int bn_mont_sqr(bn* dst, bn const* Obj, bn_mont_ctx const* mont)
+{
+	if (dst == NULL || Obj == NULL || mont == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	bn Obj_t; // квадрат до приведения
+	bn_init_local(&Obj_t, bn_ctx_current);
+
+	int res_err = bn_sqr_into(&Obj_t, Obj);
+	if (res_err == BN_OK)
+	{
+		res_err = bn_mont_reduce(dst, &Obj_t, mont);
+	}
+
+	bn_clear_local(&Obj_t);
+	return res_err;
+}
+
+// ------------------------------------------ ПРИВЕДЕНИЕ ПО БАРРЕТТУ --------------------------------------------------
+
+/* Определения приведения по Барретту: mu = floor(NOTATION^(2n) / |m|), n - длина m. После подготовки
+   структура не изменяется (временные числа - у вызывающего), поэтому ее могут разделять потоки */
+struct bn_barrett_s {
+	bn* mod; // |m|
+	bn* mu; // floor(NOTATION^(2n) / |m|)
+	size_t n; // длина модуля в ячейках
+	int sign; // знак m (остаток получает его же, как в bn_divmod)
+};
+
+/* Конструктор приведения по Барретту */
+bn_barrett* bn_barrett_init(bn const* Obj_m)
+{
+	if (Obj_m == NULL || Obj_m->sign == 0)
+	{
+		return NULL;
+	}
+
+	bn_barrett* br = (bn_barrett*)malloc(sizeof(bn_barrett));
+	if (br == NULL)
+	{
+		return NULL;
+	}
+
+	br->n = Obj_m->size;
+	br->sign = Obj_m->sign;
+	// mod и mu живут дольше операции, поэтому создаются в куче даже при текущем контексте
+	bn_ctx* prev = bn_ctx_enter(NULL);
+	br->mod = bn_init(Obj_m);
+	br->mu = bn_new();
+	bn_ctx_leave(prev);
+
+	int res_err = (br->mod == NULL || br->mu == NULL) ? BN_NO_MEMORY : BN_OK;
+	if (res_err == BN_OK)
+	{
+		br->mod->sign = 1;
+		res_err = bn_reciprocal(br->mu, br->mod);
+	}
+	if (res_err != BN_OK)
+	{
+		bn_barrett_delete(br);
+		return NULL;
+	}
+
+	return br;
+}
+
+/* Деструктор приведения по Барретту */
+int bn_barrett_delete(bn_barrett* br)
+{
+	if (br == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
+
+	bn_delete(br->mod);
+	bn_delete(br->mu);
+	free(br);
+
+	return BN_OK;
+}
+
+/* Функция для приведения по модулю: dst = x mod m */
+int bn_barrett_reduce(bn* dst, bn const* Obj, bn_barrett const* br)
+{
+	if (dst == NULL || Obj == NULL || br == NULL)
+	{
+		return BN_NULL_OBJECT;
+	}
 
-			for (size_t j = Obj1->size; j < Obj2->size; ++j)
-			{
-				Obj1->ptr_body[j] = 0;
-			}
-			Obj1->size = Obj2->size;
-		}
+	// временные числа - на стеке; остаток пишется прямо в dst, если dst не совпадает с x
+	bool direct = dst != Obj && dst->ptr_body != Obj->ptr_body;
+	bn Obj_r, Obj_t;
+	bn_init_local(&Obj_r, dst->ctx);
+	bn_init_local(&Obj_t, bn_ctx_current);
 
-		size_t i = 0;
-		int flag = 0; // параметр, сигнализирующий, о получении слишком большого числа в ячейке
+	int res_err = bn_barrett_reduce_tmp(direct ? dst : &Obj_r, Obj, br, &Obj_t);
+	if (res_err == BN_OK && !direct)
+	{
+		res_err = bn_swap(dst, &Obj_r);
+	}
 
-		for (; i < Obj2->size; ++i) {
-			Obj1->ptr_body[i] += flag + Obj2->ptr_body[i];
+	bn_clear_local(&Obj_r);
+	bn_clear_local(&Obj_t);
+	return res_err;
+}
 
-			flag = ((unsigned int)Obj1->ptr_body[i] >= NOTATION);
-			if (flag != 0)
-			{
-				Obj1->ptr_body[i] -= NOTATION;
-			}
-		}
+int bn_barrett_reduce_tmp(bn* Obj_r, bn const* Obj, bn_barrett const* br, bn* Obj_t)
+{
+	size_t n = br->n;
+	int sign = Obj->sign;
 
-		if (flag != 0)
+	if (Obj->size > 2 * n)
+	{
+		// x >= NOTATION^(2n): оценка частного теряет точность, остаток находится делением
+		bn Obj_m = *br->mod;
+		Obj_m.sign = br->sign;
+		return bn_divmod(NULL, Obj_r, Obj, &Obj_m);
+	}
+
+	bn Obj_xa = *Obj; // |x|
+	Obj_xa.sign = sign != 0;
+
+	int res_err = BN_OK;
+	if (bn_abs_cmp(Obj, br->mod) < 0)
+	{
+		res_err = Analog_assignment(Obj_r, &Obj_xa);
+	}
+	else
+	{
+		// q3 = floor(floor(x / NOTATION^(n-1)) * mu / NOTATION^(n+1)) меньше частного не больше чем на 2
+		bn Obj_q1 = Obj_xa;
+		Obj_q1.ptr_body += n - 1;
+		Obj_q1.size -= n - 1;
+
+		res_err = bn_mul_into(Obj_r, &Obj_q1, br->mu);
+		if (res_err == BN_OK && Obj_r->size > n + 1)
 		{
-			while (flag != 0 && i < Obj1->size)
-			{
-				Obj1->ptr_body[i] += flag;
-				flag = ((unsigned int)Obj1->ptr_body[i] >= NOTATION);
-				if (flag != 0)
-				{
-					Obj1->ptr_body[i] -= NOTATION;
-				}
-				++i;
-			}
+			bn Obj_q3 = *Obj_r;
+			Obj_q3.ptr_body += n + 1;
+			Obj_q3.size -= n + 1;
 
-			if (flag != 0)
-			{
-				int* arr = (int*)realloc(Obj1->ptr_body, (1 + Obj1->size) * sizeof(int));
-				if (arr == NULL)
-				{
-					return BN_NO_MEMORY;
-				}
-				else
-				{
-					Obj1->ptr_body = arr;
-				}
-				++(Obj1->size);
-				Obj1->ptr_body[Obj1->size - 1] = flag;
-			}
+			res_err = bn_mul_into(Obj_t, &Obj_q3, br->mod); // q3 * |m|
+		}
+		else if (res_err == BN_OK)
+		{
+			res_err = bn_init_int(Obj_t, 0);
 		}
 
+		if (res_err == BN_OK) res_err = bn_sub_into(Obj_r, &Obj_xa, Obj_t);
+
+		while (res_err == BN_OK && bn_abs_cmp(Obj_r, br->mod) >= 0)
+		{
+			res_err = bn_sub_to(Obj_r, br->mod);
+		}
 	}
-	else // разные знаки 
+
+	// |x| mod |m| переводится к знакам: остаток отрицательного x - |m| - r, у отрицательного m остаток не больше 0
+	if (res_err == BN_OK && sign < 0 && Obj_r->sign != 0) res_err = bn_sub_into(Obj_r, br->mod, Obj_r);
+	if (res_err == BN_OK && br->sign < 0 && Obj_r->sign != 0) res_err = bn_sub_to(Obj_r, br->mod);
+
+	return res_err;
+}
+
+// ------------------------------------------ НАИБОЛЬШИЙ ОБЩИЙ ДЕЛИТЕЛЬ ------------------------------------------------
+
+/* Определения состояния алгоритма Евклида: пара (a, b), a >= b >= 0, получена из начальной пары (a0, b0)
+   преобразованием (a0; b0) = M (a; b), где у M неотрицательные элементы и определитель det = +-1.
+   Коэффициенты при a0 в выражениях a и b через a0 и b0 всегда разных знаков, поэтому хранятся их модули */
+struct bn_gcd_s {
+	bn* a; // большее число пары
+	bn* b; // меньшее число пары
+	bn* m[4]; // элементы M по строкам (NULL - матрица не ведется)
+	bn* x[2]; // модули коэффициентов при a0 в выражениях a и b (NULL - не ведутся)
+	int det; // определитель M, он же знак коэффициента при a0 в выражении a
+};
+
+/* Функция для нахождения наибольшего общего делителя (результат неотрицателен, НОД(0, 0) = 0) */
+int bn_gcd(bn* Obj_g, bn const* Obj1, bn const* Obj2)
+{
+	if (Obj_g == NULL || Obj1 == NULL || Obj2 == NULL)
 	{
-		bn* Obj_c = bn_init(Obj2); // временная копия Obj2 со знаком +
-		bn_neg(Obj_c); // смена знака
+		return BN_NULL_OBJECT;
+	}
+
+	bool swap = bn_abs_cmp(Obj1, Obj2) < 0;
+
+	bn_gcd_state st;
+	int res_err = bn_gcd_init(&st, swap ? Obj2 : Obj1, swap ? Obj1 : Obj2, 0, false, false);
+	if (res_err == BN_OK) res_err = bn_gcd_run(&st);
+	if (res_err == BN_OK) res_err = bn_swap(Obj_g, st.a);
+
+	bn_gcd_clear(&st);
+	return res_err;
+}
 
-		int code = bn_sub_to(Obj1, Obj_c);
-		bn_delete(Obj_c);
-		return code;
+/* Функция для нахождения НОД и коэффициентов Безу: g = s * Obj1 + t * Obj2 (s или t может быть NULL) */
+int bn_gcdext(bn* Obj_g, bn* Obj_s, bn* Obj_t, bn const* Obj1, bn const* Obj2)
+{
+	if (Obj_g == NULL || Obj1 == NULL || Obj2 == NULL)
+	{
+		return BN_NULL_OBJECT;
 	}
 
-	return BN_OK;
+	// пара начинается с большего по модулю числа: g = sa * |a| + tb * |b|
+	bool swap = bn_abs_cmp(Obj1, Obj2) < 0;
+	bn const* Obj_a = swap ? Obj2 : Obj1;
+	bn const* Obj_b = swap ? Obj1 : Obj2;
+
+	bn Obj_aa = *Obj_a;
+	Obj_aa.sign = Obj_a->sign != 0;
+
+	bn_gcd_state st;
+	bn* Obj_sa = bn_new();
+	bn* Obj_tb = bn_new();
+	int res_err = Obj_sa == NULL || Obj_tb == NULL ? BN_NO_MEMORY : bn_gcd_init(&st, Obj_a, Obj_b, 0, false, true);
+	if (res_err == BN_OK) res_err = bn_gcd_run(&st);
+
+	// sa = det * x0, tb = (g - sa * |a|) / |b| (деление точное); при b = 0 g = |a|, sa = 1, tb = 0
+	if (res_err == BN_OK) res_err = Analog_assignment(Obj_sa, st.x[0]);
+	if (res_err == BN_OK && st.det < 0) res_err = bn_neg(Obj_sa);
+	if (res_err == BN_OK && Obj_a->sign == 0) res_err = bn_init_int(Obj_sa, 0);
+	if (res_err == BN_OK && Obj_b->sign == 0)
+	{
+		res_err = bn_init_int(Obj_tb, 0);
+	}
+	else if (res_err == BN_OK)
+	{
+		bn Obj_ba = *Obj_b;
+		Obj_ba.sign = 1;
+
+		res_err = bn_mul_into(Obj_tb, Obj_sa, &Obj_aa);
+		if (res_err == BN_OK) res_err = bn_sub_into(Obj_tb, st.a, Obj_tb);
+		if (res_err == BN_OK) res_err = bn_div_to(Obj_tb, &Obj_ba);
+	}
+
+	// коэффициенты при самих числах: знак числа переносится на коэффициент
+	if (res_err == BN_OK && Obj_a->sign < 0) res_err = bn_neg(Obj_sa);
+	if (res_err == BN_OK && Obj_b->sign < 0) res_err = bn_neg(Obj_tb);
+
+	// результаты записываются в конце: они могут совпадать с аргументами
+	if (res_err == BN_OK && Obj_s != NULL) res_err = bn_swap(Obj_s, swap ? Obj_tb : Obj_sa);
+	if (res_err == BN_OK && Obj_t != NULL) res_err = bn_swap(Obj_t, swap ? Obj_sa : Obj_tb);
+	if (res_err == BN_OK) res_err = bn_swap(Obj_g, st.a);
+
+	if (Obj_sa != NULL && Obj_tb != NULL)
+	{
+		bn_gcd_clear(&st);
+	}
+	bn_delete(Obj_sa);
+	bn_delete(Obj_tb);
+	return res_err;
 }
 
-/* Функция для вычитания из одного большого числа другое */
-int bn_sub_to(bn* Obj1, bn const* Obj2) {
-	if (Obj1 == NULL || Obj2 == NULL) {
+/* Функция для нахождения обратного по модулю: Obj * Obj_r = 1 mod m (знак результата - как у m);
+   если обратного нет, возвращается BN_DIVIDE_BY_ZERO */
+int bn_invert(bn* Obj_r, bn const* Obj, bn const* Obj_m)
+{
+	if (Obj_r == NULL || Obj == NULL || Obj_m == NULL)
+	{
 		return BN_NULL_OBJECT;
 	}
+	if (Obj_m->sign == 0)
+	{
+		return BN_DIVIDE_BY_ZERO;
+	}
+
+	bn Obj_ma = *Obj_m;
+	Obj_ma.sign = 1;
+
+	// число сначала приводится по модулю, чтобы алгоритм Евклида шел по числам длины модуля
+	bn* Obj_a = bn_new();
+	bn* Obj_g = bn_new();
+	bn* Obj_s = bn_new();
+	int res_err = Obj_a == NULL || Obj_g == NULL || Obj_s == NULL ? BN_NO_MEMORY : bn_divmod(NULL, Obj_a, Obj, &Obj_ma);
+	if (res_err == BN_OK) res_err = bn_gcdext(Obj_g, Obj_s, NULL, Obj_a, &Obj_ma);
+	if (res_err == BN_OK && bn_cmp_si(Obj_g, 1) != 0)
+	{
+		res_err = BN_DIVIDE_BY_ZERO;
+	}
+	if (res_err == BN_OK) res_err = bn_divmod(NULL, Obj_a, Obj_s, Obj_m);
+	if (res_err == BN_OK) res_err = bn_swap(Obj_r, Obj_a);
 
-	// Проверки на равенство нулю
-	if (Obj1->sign == 0) {
-		bn* Obj2_c = bn_init(Obj2);
-		int res_ass = Analog_assignment(Obj1, Obj2_c);
+	bn_delete(Obj_a);
+	bn_delete(Obj_g);
+	bn_delete(Obj_s);
+	return res_err;
+}
 
-		bn_neg(Obj1);
-		bn_delete(Obj2_c);
+int bn_gcd_init(bn_gcd_state* st, bn const* Obj1, bn const* Obj2, size_t k, bool matrix, bool coef)
+{
+	memset(st, 0, sizeof(bn_gcd_state));
+	st->det = 1;
 
-		return res_ass;
+	st->a = bn_new();
+	st->b = bn_new();
+	int res_err = st->a == NULL || st->b == NULL ? BN_NO_MEMORY : BN_OK;
+	for (size_t i = 0; matrix && i < 4; ++i)
+	{
+		st->m[i] = bn_new();
+		if (st->m[i] == NULL)
+		{
+			res_err = BN_NO_MEMORY;
+		}
 	}
-	if (Obj2->sign == 0) {
-		return BN_OK;
+	for (size_t i = 0; coef && i < 2; ++i)
+	{
+		st->x[i] = bn_new();
+		if (st->x[i] == NULL)
+		{
+			res_err = BN_NO_MEMORY;
+		}
 	}
 
-	if (Obj1->sign == Obj2->sign)
+	// модули a >> k и b >> k; M = E, a = 1 * a0 + 0 * b0, b = 0 * a0 + 1 * b0
+	size_t k1 = Obj1->size > k ? k : Obj1->size;
+	size_t k2 = Obj2->size > k ? k : Obj2->size;
+	if (res_err == BN_OK) res_err = bn_init_limbs(st->a, Obj1->ptr_body + k1, Obj1->size - k1);
+	if (res_err == BN_OK) res_err = bn_init_limbs(st->b, Obj2->ptr_body + k2, Obj2->size - k2);
+	if (res_err == BN_OK && matrix) res_err = bn_init_int(st->m[0], 1);
+	if (res_err == BN_OK && matrix) res_err = bn_init_int(st->m[3], 1);
+	if (res_err == BN_OK && coef) res_err = bn_init_int(st->x[0], 1);
+
+	if (res_err != BN_OK)
 	{
-		int param_res = bn_cmp(Obj1, Obj2);
+		bn_gcd_clear(st);
+	}
+	return res_err;
+}
 
-		if (param_res == 1)  // |Obj1| > |Obj2| and Obj1->sign = Obj2->sign = 1 || |Obj1| < |Obj2| and Obj1->sign = Obj2->sign = -1
+void bn_gcd_clear(bn_gcd_state* st)
+{
+	bn* all[] = { st->a, st->b, st->m[0], st->m[1], st->m[2], st->m[3], st->x[0], st->x[1] };
+	for (size_t i = 0; i < 8; ++i)
+	{
+		if (all[i] != NULL)
 		{
-			return Sub_Abs(Obj1, Obj2);
+			bn_delete(all[i]);
 		}
-		else if (param_res == -1) // |Obj1| < |Obj2| and Obj1->sign = Obj2->sign = 1 || |Obj1| > |Obj2| and Obj1->sign = Obj2->sign = -1
+	}
+
+	memset(st, 0, sizeof(bn_gcd_state));
+}
+
+bool bn_gcd_reduced(bn_gcd_state const* st)
+{
+	for (size_t i = 0; i < 4; ++i)
+	{
+		if (bn_abs_cmp(st->b, st->m[i]) < 0)
 		{
-			bn* Obj_c = bn_init(Obj2);
+			return false;
+		}
+	}
 
-			int res_err = Sub_Abs(Obj_c, Obj1);
-			if (res_err != BN_OK)
+	return true;
+}
+
+int bn_lehmer_apply(bn* x, bn* y, long long A, long long B, long long C, long long D)
+{
+	size_t n = x->size > y->size ? x->size : y->size;
+
+	int res_err = bn_grow(x, n + 2);
+	if (res_err == BN_OK) res_err = bn_grow(y, n + 2);
+	if (res_err != BN_OK)
+	{
+		return res_err;
+	}
+
+	memset(x->ptr_body + x->size, 0, (n + 2 - x->size) * sizeof(int));
+	memset(y->ptr_body + y->size, 0, (n + 2 - y->size) * sizeof(int));
+	bn_limbs_lehmer(x->ptr_body, y->ptr_body, n, A, B, C, D);
+
+	x->size = y->size = n + 2;
+	x->sign = y->sign = 1;
+
+	res_err = Clean_Nulls_Front(x);
+	if (res_err == BN_OK) res_err = Clean_Nulls_Front(y);
+
+	return res_err;
+}
+
+int bn_lehmer_word(bn const* a, bn const* b, long long* q)
+{
+	size_t n = a->size;
+	const long long base = NOTATION;
+	long long ah = 0, bh = 0; // старшие цифры a и цифры b в тех же разрядах
+
+	// числа до двух ячеек берутся целиком, и частные считаются точно
+	bool exact = n <= 2;
+	if (exact)
+	{
+		ah = a->ptr_body[0] + (n > 1 ? a->ptr_body[1] * base : 0);
+		bh = b->ptr_body[0] + (b->size > 1 ? b->ptr_body[1] * base : 0);
+	}
+	else
+	{
+		// старшая ячейка a дополняется цифрами двух следующих до 18 десятичных цифр
+		long long top_a[3], top_b[3];
+		for (size_t i = 0; i < 3; ++i)
+		{
+			top_a[i] = a->ptr_body[n - 1 - i];
+			top_b[i] = n - 1 - i < b->size ? b->ptr_body[n - 1 - i] : 0;
+		}
+
+		long long cut = 1; // 10^(количество цифр в старшей ячейке a)
+		for (; cut <= top_a[0]; cut *= 10);
+		long long scale = base / cut;
+
+		ah = (top_a[0] * base + top_a[1]) * scale + top_a[2] / cut;
+		bh = (top_b[0] * base + top_b[1]) * scale + top_b[2] / cut;
+	}
+
+	// алгоритм L Кнута: частное принимается, если оно одинаково для обеих границ, в которых лежат a / b;
+	// модули коэффициентов не выходят за NOTATION - 1, чтобы матрица применялась за один проход
+	const long long limit = base - 1;
+	long long A = 1, B = 0, C = 0, D = 1;
+	while (true)
+	{
+		long long qq = 0;
+		if (exact)
+		{
+			if (bh == 0)
 			{
-				return res_err;
+				break;
 			}
+			qq = ah / bh;
+		}
+		else
+		{
+			if (bh + C <= 0 || bh + D <= 0 || ah + A < 0 || ah + B < 0)
+			{
+				break;
+			}
+			qq = (ah + A) / (bh + C);
+			if (qq == 0 || qq != (ah + B) / (bh + D))
+			{
+				break;
+			}
+		}
 
-			res_err = Analog_assignment(Obj1, Obj_c);
-			bn_neg(Obj1);
-			bn_delete(Obj_c);
-
-			return res_err;
+		// новые коэффициенты A - qC и B - qD: знаки чередуются, модули складываются
+		long long abs_a = A < 0 ? -A : A, abs_b = B < 0 ? -B : B;
+		long long abs_c = C < 0 ? -C : C, abs_d = D < 0 ? -D : D;
+		if ((abs_c != 0 && qq > (limit - abs_a) / abs_c) || (abs_d != 0 && qq > (limit - abs_b) / abs_d))
+		{
+			break;
 		}
-		else // param_res == 0
+
+		long long T = A - qq * C;
+		A = C;
+		C = T;
+		T = B - qq * D;
+		B = D;
+		D = T;
+		T = ah - qq * bh;
+		ah = bh;
+		bh = T;
+	}
+
+	q[0] = A;
+	q[1] = B;
+	q[2] = C;
+	q[3] = D;
+	return B != 0;
+}
+
+int bn_gcd_word_step(bn_gcd_state* st, const long long* q)
+{
+	long long A = q[0], B = q[1], C = q[2], D = q[3];
+	long long d = A * D - B * C; // определитель шага, +-1
+
+	// (a; b) = Q (a; b); M = M Q^(-1), Q^(-1) = d (D -B; -C A);
+	// модули коэффициентов: |x0| = d (A |x0| - B |x1|), |x1| = d (D |x1| - C |x0|)
+	int res_err = bn_lehmer_apply(st->a, st->b, A, B, C, D);
+	if (res_err == BN_OK && st->x[0] != NULL) res_err = bn_lehmer_apply(st->x[0], st->x[1], d * A, -d * B, -d * C, d * D);
+	if (res_err == BN_OK && st->m[0] != NULL) res_err = bn_lehmer_apply(st->m[0], st->m[1], d * D, -d * C, -d * B, d * A);
+	if (res_err == BN_OK && st->m[0] != NULL) res_err = bn_lehmer_apply(st->m[2], st->m[3], d * D, -d * C, -d * B, d * A);
+	st->det *= (int)d;
+
+	return res_err;
+}
+
+int bn_gcd_div_step(bn_gcd_state* st, bool* done)
+{
+	// q = a / b, r = a mod b; новые первые столбцы M: q * m00 + m01 и q * m10 + m11
+	bn* Obj_q = bn_new();
+	bn* Obj_r = bn_new();
+	bn* Obj_t0 = bn_new();
+	bn* Obj_t1 = bn_new();
+	int res_err = Obj_q == NULL || Obj_r == NULL || Obj_t0 == NULL || Obj_t1 == NULL ? BN_NO_MEMORY : bn_divmod(Obj_q, Obj_r, st->a, st->b);
+
+	if (res_err == BN_OK && st->m[0] != NULL)
+	{
+		res_err = bn_mul_into(Obj_t0, Obj_q, st->m[0]);
+		if (res_err == BN_OK) res_err = bn_add_to(Obj_t0, st->m[1]);
+		if (res_err == BN_OK) res_err = bn_mul_into(Obj_t1, Obj_q, st->m[2]);
+		if (res_err == BN_OK) res_err = bn_add_to(Obj_t1, st->m[3]);
+
+		// пара после шага должна остаться приведенной
+		if (res_err == BN_OK && (bn_abs_cmp(Obj_r, Obj_t0) < 0 || bn_abs_cmp(Obj_r, Obj_t1) < 0))
 		{
-			bn* bn_null = bn_new();
-			int res_ass = Analog_assignment(Obj1, bn_null);
-			bn_delete(bn_null);
-			return res_ass;
+			*done = false;
+			bn_delete(Obj_q);
+			bn_delete(Obj_r);
+			bn_delete(Obj_t0);
+			bn_delete(Obj_t1);
+			return BN_OK;
 		}
 	}
-	else // разные знаки
+
+	// (a, b) = (b, r); M = M (q 1; 1 0); |x0| = |x1|, |x1| = |x0| + q |x1|
+	if (res_err == BN_OK) res_err = bn_swap(st->a, st->b);
+	if (res_err == BN_OK) res_err = bn_swap(st->b, Obj_r);
+	if (res_err == BN_OK && st->m[0] != NULL)
+	{
+		res_err = bn_swap(st->m[0], st->m[1]);
+		if (res_err == BN_OK) res_err = bn_swap(st->m[0], Obj_t0);
+		if (res_err == BN_OK) res_err = bn_swap(st->m[2], st->m[3]);
+		if (res_err == BN_OK) res_err = bn_swap(st->m[2], Obj_t1);
+	}
+	if (res_err == BN_OK && st->x[0] != NULL)
+	{
+		res_err = bn_mul_into(Obj_t0, Obj_q, st->x[1]);
+		if (res_err == BN_OK) res_err = bn_add_to(Obj_t0, st->x[0]);
+		if (res_err == BN_OK) res_err = bn_swap(st->x[0], st->x[1]);
+		if (res_err == BN_OK) res_err = bn_swap(st->x[1], Obj_t0);
+	}
+	st->det = -st->det;
+	*done = true;
+
+	bn_delete(Obj_q);
+	bn_delete(Obj_r);
+	bn_delete(Obj_t0);
+	bn_delete(Obj_t1);
+	return res_err;
+}
+
+int bn_gcd_step(bn_gcd_state* st, bool* done)
+{
+	long long q[4];
+	if (!bn_lehmer_word(st->a, st->b, q))
 	{
-		bn* Obj_c = bn_init(Obj2);
-		bn_neg(Obj_c);
+		// старших цифр не хватает даже на одно частное: шаг делением
+		return bn_gcd_div_step(st, done);
+	}
 
-		int code = bn_add_to(Obj1, Obj_c);
-		bn_delete(Obj_c);
-		return code;
+	int res_err = bn_gcd_word_step(st, q);
+	*done = true;
+
+	if (res_err == BN_OK && st->m[0] != NULL && !bn_gcd_reduced(st))
+	{
+		// шаг вывел пару из приведенных: он отменяется обратной матрицей d (D -B; -C A)
+		long long d = q[0] * q[3] - q[1] * q[2];
+		long long q_inv[4] = { d * q[3], -d * q[1], -d * q[2], d * q[0] };
+		res_err = bn_gcd_word_step(st, q_inv);
+		*done = false;
 	}
 
-	return BN_OK;
+	return res_err;
 }
 
-/* Функция для умножения из одного большого числа другое */
-int bn_mul_to(bn* Obj1, bn const* Obj2)
+int bn_dot2(bn* dst, bn const* x1, bn const* y1, bn const* x2, bn const* y2, int sign, bn* t)
 {
-	return bn_mul_col(Obj1, Obj2);
+	int res_err = bn_mul_into(dst, x1, y1);
+	if (res_err == BN_OK) res_err = bn_mul_into(t, x2, y2);
+	if (res_err == BN_OK) res_err = sign > 0 ? bn_add_to(dst, t) : bn_sub_to(dst, t);
+
+	return res_err;
 }
 
-/* Функция для деления одного большого числа на другое */
-int bn_div_to(bn* Obj1, bn const* Obj2)
+int bn_hgcd_top(bn_gcd_state* st, size_t k, bool* done)
 {
-	if (Obj1 == NULL || Obj2 == NULL)
+	*done = false;
+	if (st->b->size <= k + 1)
 	{
-		return BN_NULL_OBJECT;
+		return BN_OK;
 	}
 
-	if (Obj2->sign == 0)
+	// половинный НОД старших ячеек: его пара приведена, поэтому матрица R верна и для всей пары
+	bn_gcd_state sub;
+	int res_err = bn_gcd_init(&sub, st->a, st->b, k, true, false);
+	if (res_err == BN_OK) res_err = bn_hgcd(&sub);
+	if (res_err != BN_OK || (sub.m[1]->sign == 0 && sub.m[2]->sign == 0))
 	{
-		return BN_DIVIDE_BY_ZERO;
+		bn_gcd_clear(&sub);
+		return res_err;
 	}
-	if (Obj1->sign == 0)
+
+	bn* const* r = sub.m;
+	int sign = sub.det;
+
+	// (a; b) = R^(-1) (a; b) = det (r11 a - r01 b; r00 b - r10 a); M = M R; |x| = (r11 r01; r10 r00) |x|
+	bn* t[9] = { NULL };
+	for (size_t i = 0; i < 9 && res_err == BN_OK; ++i)
 	{
-		return BN_OK;
+		t[i] = bn_new();
+		if (t[i] == NULL)
+		{
+			res_err = BN_NO_MEMORY;
+		}
+	}
+	if (res_err == BN_OK) res_err = bn_dot2(t[0], r[3], st->a, r[1], st->b, -1, t[8]);
+	if (res_err == BN_OK) res_err = bn_dot2(t[1], r[0], st->b, r[2], st->a, -1, t[8]);
+	if (res_err == BN_OK && sign < 0) res_err = bn_neg(t[0]);
+	if (res_err == BN_OK && sign < 0) res_err = bn_neg(t[1]);
+	if (res_err == BN_OK && st->m[0] != NULL)
+	{
+		for (size_t i = 0; i < 4 && res_err == BN_OK; ++i)
+		{
+			// (M R)[i] = m[row][0] * r[col] + m[row][1] * r[2 + col]
+			size_t row = i / 2, col = i % 2;
+			res_err = bn_dot2(t[2 + i], st->m[2 * row], r[col], st->m[2 * row + 1], r[2 + col], 1, t[8]);
+		}
 	}
 
-	bn* Obj2_c = bn_init(Obj2); // копия второго объекта
-	bn_abs(Obj2_c); // делаем знак положительным
+	// матрица половинного НОД гарантирует неотрицательность; порядок пары мог смениться
+	bool swap = false;
+	bool accept = res_err == BN_OK && t[0]->sign >= 0 && t[1]->sign >= 0;
+	if (accept)
+	{
+		swap = bn_abs_cmp(t[0], t[1]) < 0;
+		if (swap)
+		{
+			res_err = bn_swap(t[0], t[1]);
+			if (res_err == BN_OK && st->m[0] != NULL) res_err = bn_swap(t[2], t[3]);
+			if (res_err == BN_OK && st->m[0] != NULL) res_err = bn_swap(t[4], t[5]);
+		}
+	}
+	if (accept && res_err == BN_OK && st->m[0] != NULL)
+	{
+		// внутри половинного НОД пара после шага должна остаться приведенной
+		for (size_t i = 0; i < 4; ++i)
+		{
+			accept = accept && bn_abs_cmp(t[1], t[2 + i]) >= 0;
+		}
+	}
 
-	bn* Obj_r = bn_new(); // результат деления
-	int res_err = bn_add_nulls_begin(Obj_r, Obj1->size); // добавление ведущих нулей для инициализации
-	if (res_err != BN_OK)
+	if (accept && res_err == BN_OK)
 	{
-		return res_err;
+		res_err = bn_swap(st->a, t[0]);
+		if (res_err == BN_OK) res_err = bn_swap(st->b, t[1]);
+		for (size_t i = 0; res_err == BN_OK && st->m[0] != NULL && i < 4; ++i)
+		{
+			res_err = bn_swap(st->m[i], t[2 + i]);
+		}
+		if (res_err == BN_OK && st->x[0] != NULL)
+		{
+			res_err = bn_dot2(t[6], r[3], st->x[0], r[1], st->x[1], 1, t[8]);
+			if (res_err == BN_OK) res_err = bn_dot2(t[7], r[2], st->x[0], r[0], st->x[1], 1, t[8]);
+			if (res_err == BN_OK) res_err = bn_swap(st->x[0], swap ? t[7] : t[6]);
+			if (res_err == BN_OK) res_err = bn_swap(st->x[1], swap ? t[6] : t[7]);
+		}
+		st->det *= swap ? -sign : sign;
+		*done = true;
+	}
+
+	for (size_t i = 0; i < 9; ++i)
+	{
+		if (t[i] != NULL)
+		{
+			bn_delete(t[i]);
+		}
+	}
+	bn_gcd_clear(&sub);
+	return res_err;
+}
+
+int bn_hgcd(bn_gcd_state* st)
+{
+	size_t n = st->a->size;
+	int res_err = BN_OK;
+	bool done = true;
+
+	if (n >= BN_HGCD_THRESHOLD)
+	{
+		// матрица старшей половины сокращает пару примерно до 3n/4 ячеек, остаток - отдельными шагами
+		res_err = bn_hgcd_top(st, n / 2, &done);
+		done = true;
+		while (res_err == BN_OK && done && st->b->sign != 0 && st->a->size > 3 * n / 4 + 1)
+		{
+			res_err = bn_gcd_step(st, &done);
+		}
+
+		// вторая рекурсия по старшим 2(n1 - n/2) ячейкам доводит пару примерно до n/2 ячеек
+		// (с запасом в одну ячейку, чтобы пара осталась приведенной)
+		size_t n1 = st->a->size;
+		if (res_err == BN_OK && done && 2 * n1 > n + 1)
+		{
+			res_err = bn_hgcd_top(st, n - n1 + 1, &done);
+			done = true;
+		}
+	}
+
+	// остаток пути - шаги Лемера и деления, пока пара остается приведенной
+	while (res_err == BN_OK && done && st->b->sign != 0)
+	{
+		res_err = bn_gcd_step(st, &done);
+	}
+
+	return res_err;
+}
+
+int bn_gcd_run(bn_gcd_state* st)
+{
+	int res_err = BN_OK;
+	while (res_err == BN_OK && st->b->sign != 0)
+	{
+		bool done = false;
+		if (st->a->size >= BN_GCD_HGCD_THRESHOLD)
+		{
+			// половинный НОД старших 2/3 ячеек сокращает пару примерно на треть длины
+			res_err = bn_hgcd_top(st, st->a->size / 3, &done);
+		}
+		if (res_err == BN_OK && !done)
+		{
+			res_err = bn_gcd_step(st, &done);
+		}
 	}
 
-	bn* Obj_cur = bn_new(); // текущее делимое
+	return res_err;
+}
 
-	for (long int i = Obj1->size - 1; i >= 0; --i)
-	{
-		res_err = bn_shift_right(Obj_cur);
-		if (res_err != BN_OK)
-		{
-			return res_err;
-		}
+// ------------------------------------------ ЧИСЛА С ДВОИЧНЫМИ ЯЧЕЙКАМИ -----------------------------------------------
 
-		Obj_cur->ptr_body[0] = Obj1->ptr_body[i];
-		Obj_cur->sign = 1;
+/* Определения структуры bn_bin: ячейки по 64 бита, произведения - в 128-битных целых (без них - по 32-битным половинам) */
+struct bn_bin_s {
+	unsigned long long* ptr_body; // указатель на начало массива ячеек (основание 2^64)
+	size_t size; // размер массива
+	size_t capacity; // количество ячеек, под которые выделена память
+	int sign; // знак числа
+};
 
-		int curr_num = 0; // результат деления Obj_cur на делитель
-		unsigned int l_hold = 0, // левая граница диапазона значения искомой ячейки числа
-			r_hold = NOTATION; // правая граница диапазона значения искомой ячейки числа 
+// Функция для увеличения емкости массива с запасом (не меняет размер числа)
+int bn_bin_grow(bn_bin*, size_t);
 
-		if (bn_cmp(Obj_cur, Obj2_c) != -1)
-		{
-			bn* Obj_cmp = bn_new(); // большое число для бинарного поиска
+// Аналог присваивания
+int bn_bin_assign(bn_bin*, bn_bin const*);
 
-			while (l_hold <= r_hold)
-			{
-				int mid_now = (l_hold + r_hold) / 2;
+// Функция для удаления впереди идущих нулей
+void bn_bin_normalize(bn_bin*);
 
-				res_err = bn_init_int(Obj_cmp, mid_now);
-				if (res_err != BN_OK)
-				{
-					return res_err;
-				}
+// Функция для сложения (negate = 0) или вычитания (negate = 1) с учетом знаков
+int bn_bin_add_signed(bn_bin*, bn_bin const*, int negate);
 
-				int res_err = bn_mul_to(Obj_cmp, Obj2_c);
-				if (res_err != BN_OK)
-				{
-					return res_err;
-				}
+// Функция, возвращающая b, если radix = 2^b, и 0 иначе
+int bn_bin_radix_bits(int radix);
 
-				int res_cmp1 = bn_cmp(Obj_cmp, Obj_cur);
-				if (res_cmp1 != 1)
-				{
-					curr_num = mid_now;
-					l_hold = mid_now + 1;
-				}
-				else
-				{
-					r_hold = mid_now - 1;
-				}
-			}
+// Функции для записи и разбора строки в системе счисления 2^b прямо по группам из b бит
+char* bn_bin_to_string_pow2(bn_bin const*, int bits);
+int bn_bin_init_string_pow2(bn_bin*, const char* str, size_t length, int bits);
 
-			bn_delete(Obj_cmp);
-		}
+// Функция для перевода модуля из ячеек BN: старшая часть умножается на NOTATION^(2^level) из кэша
+int bn_bin_from_limbs(bn_bin*, const int*, size_t);
 
-		Obj_r->ptr_body[i] = curr_num;
+// Функция для получения NOTATION^(2^level) в двоичном виде из кэша, NULL при нехватке памяти
+bn_bin const* bn_bin_notation_power(size_t level);
 
-		if (curr_num != 0)
-		{
-			bn* Obj_sub = bn_new();
-			res_err = bn_init_int(Obj_sub, curr_num);
-			if (res_err != BN_OK)
-			{
-				return res_err;
-			}
+// Функции над массивами 64-битных ячеек (младшая ячейка первая), аналогичные bn_limbs_*
+// Произведение a * b = hi * 2^64 + lo (возвращается lo) и частное (hi * 2^64 + lo) / d при hi < d (остаток - в rem):
+// через 128-битные целые, где они есть, иначе по 32-битным половинам
+unsigned long long bn_bin_mul_64(unsigned long long a, unsigned long long b, unsigned long long* hi);
+unsigned long long bn_bin_div_128(unsigned long long hi, unsigned long long lo, unsigned long long d, unsigned long long* rem);
 
-			res_err = bn_mul_to(Obj_sub, Obj2_c);
-			if (res_err != BN_OK)
-			{
-				return res_err;
-			}
+// Количество ведущих нулевых бит ненулевого числа
+int bn_bin_clz(unsigned long long);
 
-			res_err = bn_sub_to(Obj_cur, Obj_sub);
-			if (res_err != BN_OK)
-			{
-				return res_err;
-			}
-			bn_delete(Obj_sub);
-		}
-	}
+unsigned long long bn_bin_limbs_add(unsigned long long* r, const unsigned long long* a, size_t na, const unsigned long long* b, size_t nb);
+unsigned long long bn_bin_limbs_sub(unsigned long long* r, const unsigned long long* a, size_t na, const unsigned long long* b, size_t nb);
+unsigned long long bn_bin_limbs_add_to(unsigned long long* r, size_t nr, const unsigned long long* a, size_t na);
+int bn_bin_limbs_cmp(const unsigned long long* a, const unsigned long long* b, size_t n);
+unsigned long long bn_bin_limbs_mul_1(unsigned long long* r, const unsigned long long* a, size_t n, unsigned long long d);
+unsigned long long bn_bin_limbs_submul_1(unsigned long long* r, const unsigned long long* a, size_t n, unsigned long long d);
+unsigned long long bn_bin_limbs_div_1(unsigned long long* q, const unsigned long long* a, size_t n, unsigned long long d);
+void bn_bin_limbs_mul_basecase(unsigned long long* r, const unsigned long long* a, size_t na, const unsigned long long* b, size_t nb);
+void bn_bin_limbs_mul_karatsuba(unsigned long long* r, const unsigned long long* a, size_t na, const unsigned long long* b, size_t nb, unsigned long long* tmp);
+int bn_bin_limbs_divrem(unsigned long long* q, unsigned long long* r, const unsigned long long* a, size_t na, const unsigned long long* b, size_t nb);
 
-	Obj_r->sign = Obj1->sign * Obj2->sign;
-	res_err = Clean_Nulls_Front(Obj_cur);
-	if (res_err != BN_OK)
+/* Конструктор */
+bn_bin* bn_bin_new()
+{
+	bn_bin* ptr_bn = (bn_bin*)malloc(sizeof(bn_bin));
+	if (ptr_bn == NULL)
 	{
-		return res_err;
+		return NULL;
 	}
 
-	if (Obj_r->sign == -1 && Obj_cur->sign != 0)
+	ptr_bn->size = 1;
+	ptr_bn->capacity = 1;
+	ptr_bn->sign = 0;
+	ptr_bn->ptr_body = (unsigned long long*)calloc(ptr_bn->capacity, sizeof(unsigned long long));
+
+	if (ptr_bn->ptr_body == NULL)
 	{
-		bn* Obj_ed = bn_new();
-		Obj_ed->sign = 1;
-		Obj_ed->ptr_body[0] = 1;
+		free(ptr_bn);
+		return NULL;
+	}
 
-		res_err = bn_sub_to(Obj_r, Obj_ed);
-		bn_delete(Obj_ed);
+	return ptr_bn;
+}
 
-		if (res_err != BN_OK)
-		{
-			return res_err;
-		}
+/* Конструктор копирования */
+bn_bin* bn_bin_init(bn_bin const* Obj)
+{
+	if (Obj == NULL)
+	{
+		return NULL;
 	}
 
-	bn_delete(Obj_cur);
-	bn_delete(Obj2_c);
+	bn_bin* ptr_cbn = bn_bin_new();
+	if (ptr_cbn == NULL)
+	{
+		return NULL;
+	}
 
-	res_err = Clean_Nulls_Front(Obj_r);
-	if (res_err != BN_OK)
+	if (bn_bin_assign(ptr_cbn, Obj) != BN_OK)
 	{
-		return res_err;
+		bn_bin_delete(ptr_cbn);
+		return NULL;
 	}
 
-    res_err = Analog_assignment(Obj1, Obj_r);
-	bn_delete(Obj_r);
-	return res_err;
+	return ptr_cbn;
 }
 
-/* Функция для взятие остатка числа */
-int bn_mod_to(bn* Obj1, bn const* Obj2)
+/* Деструктор */
+int bn_bin_delete(bn_bin* Obj)
 {
-	if (Obj1 == NULL || Obj2 == NULL)
+	if (Obj == NULL)
 	{
 		return BN_NULL_OBJECT;
 	}
 
-	if (Obj2->sign == 0)
-	{
-		return BN_DIVIDE_BY_ZERO;
-	}
-	if (Obj1->sign == 0)
-	{
-		return BN_OK;
-	}
+	free(Obj->ptr_body);
+	free(Obj);
 
-	bn* Obj_c = bn_init(Obj1);
+	return BN_OK;
+}
 
-	int res_err = bn_div_to(Obj_c, Obj2);
-	if (res_err != BN_OK)
+/* Функция для резервирования памяти под заданное количество ячеек */
+int bn_bin_reserve(bn_bin* Obj, size_t capacity)
+{
+	if (Obj == NULL)
 	{
-		bn_delete(Obj_c);
-		return res_err;
+		return BN_NULL_OBJECT;
 	}
-
-	res_err = bn_mul_to(Obj_c, Obj2);
-	if (res_err != BN_OK)
+	if (Obj->capacity >= capacity)
 	{
-		bn_delete(Obj_c);
-		return res_err;
+		return BN_OK;
 	}
 
-	res_err = bn_sub_to(Obj1, Obj_c);
-	if (res_err != BN_OK)
+	unsigned long long* arr = (unsigned long long*)realloc(Obj->ptr_body, capacity * sizeof(unsigned long long));
+	if (arr == NULL)
 	{
-		bn_delete(Obj_c);
-		return res_err;
+		return BN_NO_MEMORY;
 	}
 
-	res_err = Clean_Nulls_Front(Obj1);
-	bn_delete(Obj_c);
+	Obj->ptr_body = arr;
+	Obj->capacity = capacity;
 
-	return res_err;
+	return BN_OK;
 }
 
-/* Функция для быстрого возведения в степень */
-int bn_pow_to(bn* Obj, int degree)
+/* Функция для присваивания */
+int bn_bin_assign(bn_bin* Obj1, bn_bin const* Obj2)
 {
-	if (Obj == NULL)
+	if (Obj1 == NULL || Obj2 == NULL)
 	{
 		return BN_NULL_OBJECT;
 	}
-
-	if (degree == 0) // степень - ноль 
+	if (Obj1 == Obj2)
 	{
-		bn* bn_ed = bn_new();
-		bn_ed->sign = 1;
-		bn_ed->ptr_body[0] = 1;
-
-		int res_err = Analog_assignment(Obj, bn_ed);
-		bn_delete(bn_ed);
-
-		return res_err;
+		return BN_OK;
 	}
-	if (degree == 1 || Obj->sign == 0)
+
+	int res_err = bn_bin_grow(Obj1, Obj2->size);
+	if (res_err != BN_OK)
 	{
-		return BN_OK;
+		return res_err;
 	}
 
-	int abs_degree = abs(degree); // для возведения только в неотрицательную степень
+	memcpy(Obj1->ptr_body, Obj2->ptr_body, Obj2->size * sizeof(unsigned long long));
+	Obj1->size = Obj2->size;
+	Obj1->sign = Obj2->sign;
 
-	bn* Obj_c = bn_new();
-	Obj_c->sign = 1;
-	Obj_c->ptr_body[0] = 1;
+	return BN_OK;
+}
 
-	while (abs_degree)
+/* Инициализация целым числом */
+int bn_bin_init_int(bn_bin* Obj, long long num)
+{
+	if (Obj == NULL)
 	{
-		if (!(abs_degree & 1))
-		{
-			abs_degree >>= 1;
-
-			int res_mul = bn_mul_to(Obj, Obj);
-			if (res_mul != BN_OK)
-			{
-				return res_mul;
-			}
-		}
-		else
-		{
-			--abs_degree;
-
-			int res_mul = bn_mul_to(Obj_c, Obj);
-			if (res_mul != BN_OK)
-			{
-				return res_mul;
-			}
-		}
+		return BN_NULL_OBJECT;
 	}
 
-	int res_ass = Analog_assignment(Obj, Obj_c);
-	bn_delete(Obj_c);
+	// модуль считается в беззнаковом типе, чтобы не переполниться на LLONG_MIN
+	Obj->ptr_body[0] = num < 0 ? 0ull - (unsigned long long)num : (unsigned long long)num;
+	Obj->size = 1;
+	Obj->sign = (num > 0) - (num < 0);
 
-	return res_ass;
+	return BN_OK;
 }
 
-/* Функция для взятия корня большого числа */
-int bn_root_to(bn* Obj, int root)
+/* Инициализация значения десятичным представлением строки */
+int bn_bin_init_string(bn_bin* Obj, const char* str)
 {
-	if (Obj == NULL)
+	return bn_bin_init_string_radix(Obj, str, 10);
+}
+
+/* Инициализация значения представлением строки в системе счисления radix */
+int bn_bin_init_string_radix(bn_bin* Obj, const char* str, int radix)
+{
+	if (Obj == NULL || str == NULL)
 	{
 		return BN_NULL_OBJECT;
 	}
-	if (root < 1)
+	if (radix < 2 || radix > 36 || bn_check_digits(str, radix) != BN_OK)
 	{
-		printf("\nПроверьте корректность передаваемых данных.\n");
-		return BN_OK;
+		return BN_INVALID_ARGUMENT;
 	}
-	if (Obj->sign == 0)
+
+	size_t length = strlen(str); // длина строки
+	size_t i = 0; // индекс текущего рассматриваемого символа
+	int sign = 1; // знак числа
+
+	if (str[0] == '-') // проверка на отрицательность
 	{
-		return BN_OK;
+		sign = -1;
+		++i;
 	}
-	if (root % 2 == 0 && Obj->sign == -1)
+	for (; i < length && str[i] == '0'; ++i);
+
+	Obj->size = 1;
+	Obj->ptr_body[0] = 0;
+	Obj->sign = 0;
+
+	if (i == length) // строка закончилась
 	{
-		printf("\nОперация взятия такого корня из отрицательного числа невозможна.\n");
 		return BN_OK;
 	}
-	if (root == 2)
-	{
-		bn* Obj_r = bn_sqrt(Obj);
-		int res_err = Analog_assignment(Obj, Obj_r);
-		
-		bn_delete(Obj_r);
-		return res_err;
-	}
 
-
-	if (Obj->size == 1)
+	int bits = bn_bin_radix_bits(radix);
+	if (bits != 0)
 	{
-		bn* Obj_r = bn_new();
-		int res_err = bn_init_int(Obj_r, (int)pow(Obj->ptr_body[0], 1 / (double)root));
+		int res_err = bn_bin_init_string_pow2(Obj, str + i, length - i, bits);
 		if (res_err != BN_OK)
 		{
 			return res_err;
 		}
-		Obj_r->sign = Obj->sign;
-
-		res_err = Analog_assignment(Obj, Obj_r);
-		bn_delete(Obj_r);
 
-		return res_err;
+		Obj->sign = sign;
+		return BN_OK;
 	}
 
-
-	bn* Obj_r = bn_new();
-	Obj_r->sign = 1;
-	Obj_r->ptr_body[0] = 1;
-
-	bn* Obj_root = bn_new();
-	int res_err = bn_init_int(Obj_root, root);
-	if (res_err != BN_OK)
+	// в одну ячейку собирается по k цифр: radix^k < 2^64
+	size_t k = 1;
+	unsigned long long big = radix; // radix^k
+	while (big <= ~0ull / radix)
 	{
-		return res_err;
+		big *= radix;
+		++k;
 	}
 
-	bn* Obj_c = bn_init(Obj);
-	res_err = bn_abs(Obj_c);
+	int res_err = bn_bin_reserve(Obj, (size_t)((length - i) * log2((double)radix) / 64) + 2);
 	if (res_err != BN_OK)
 	{
 		return res_err;
 	}
 
-	bool ind_r = false;
-	bn* Obj_curr = bn_init(Obj_r);
-
-	for (;;)
+	// схема Горнера по блокам из k цифр; первый блок может быть короче
+	size_t first = (length - i) % k == 0 ? k : (length - i) % k;
+	for (size_t j = i; j < length;)
 	{
-		
-		if (Obj_curr->size / root) Obj_curr->size /= root;
-		
-		bn* Obj_oper1 = bn_pow(Obj_r, root);
-		bn* Obj_oper2 = bn_pow(Obj_r, root - 1);
+		size_t len = j == i ? first : k;
+		unsigned long long mult = 1, chunk = 0;
 
-		res_err = bn_sub_to(Obj_oper1, Obj_c);
-		if (res_err != BN_OK)
+		for (size_t t = 0; t < len; ++t, ++j)
 		{
-			bn_delete(Obj_oper1);
-			bn_delete(Obj_oper2);
-			return res_err;
-		}
-
-		res_err = bn_mul_to(Obj_oper2, Obj_root);
-		if (res_err != BN_OK) {
-			bn_delete(Obj_oper1);
-			bn_delete(Obj_oper2);
-			return res_err;
-		}
-
-		res_err = bn_div_to(Obj_oper1, Obj_oper2);
-		if (res_err != BN_OK) {
-			bn_delete(Obj_oper1);
-			bn_delete(Obj_oper2);
-			return res_err;
+			chunk = chunk * radix + char_to_int(str[j]);
+			mult *= radix;
 		}
 
-		res_err = bn_sub_to(Obj_curr, Obj_oper1);
-		if (res_err != BN_OK)
+		unsigned long long flag = bn_bin_limbs_mul_1(Obj->ptr_body, Obj->ptr_body, Obj->size, mult);
+		flag += bn_bin_limbs_add(Obj->ptr_body, Obj->ptr_body, Obj->size, &chunk, 1);
+		if (flag != 0)
 		{
-			bn_delete(Obj_oper1);
-			bn_delete(Obj_oper2);
-			return res_err;
+			res_err = bn_bin_grow(Obj, Obj->size + 1);
+			if (res_err != BN_OK)
+			{
+				return res_err;
+			}
+			Obj->ptr_body[Obj->size++] = flag;
 		}
+	}
 
-		bn_delete(Obj_oper1);
-		bn_delete(Obj_oper2);
-
-		if (bn_cmp(Obj_r, Obj_curr) == 0 || (bn_cmp(Obj_r, Obj_curr) < 0 && ind_r))
-		{
-			break;
-		}
+	Obj->sign = sign;
+	bn_bin_normalize(Obj);
 
-		ind_r = bn_cmp(Obj_r, Obj_curr);
+	return BN_OK;
+}
 
-		res_err = Analog_assignment(Obj_r, Obj_curr);
-		if (res_err != BN_OK)
-		{
-			return res_err;
-		}
-		
+/* Функция для представления числа в системе счисления radix в виде строки */
+char* bn_bin_to_string(bn_bin const* Obj, int radix)
+{
+	if (Obj == NULL)
+	{
+		return NULL;
 	}
-
-	bn_delete(Obj_curr);
-	bn_delete(Obj_root);
-
-	bn* Obj_ed = bn_new();
-	Obj_ed->sign = 1;
-	Obj_ed->ptr_body[0] = 1;
-	
-	bn* Obj_oper = bn_pow(Obj_r, root);
-	while (bn_cmp(Obj_oper, Obj_c) == 1)
+	if (radix < 2 || radix > 36)
 	{
-		res_err = bn_sub_to(Obj_r, Obj_ed);
-		if (res_err != BN_OK)
-		{
-			bn_delete(Obj_oper);
-			bn_delete(Obj_ed);
-			bn_delete(Obj_c);
-			bn_delete(Obj_r);
-			return res_err;
-		}
-
-		res_err = Analog_assignment(Obj_oper, Obj_r);
-		if (res_err != BN_OK) {
-			bn_delete(Obj_oper);
-			bn_delete(Obj_ed);
-			bn_delete(Obj_c);
-			bn_delete(Obj_r);
-			return res_err;
-		}
-
-		res_err = bn_pow_to(Obj_oper, root);
-		if (res_err != BN_OK) {
-			bn_delete(Obj_oper);
-			bn_delete(Obj_ed);
-			bn_delete(Obj_c);
-			bn_delete(Obj_r);
-			return res_err;
-		}
+		return NULL;
 	}
 
-	bn_delete(Obj_oper);
-	bn_delete(Obj_ed);
-	bn_delete(Obj_c);
-
-	Obj_r->sign = Obj->sign;
-	res_err = Analog_assignment(Obj, Obj_r);
-	bn_delete(Obj_r);
+	int bits = bn_bin_radix_bits(radix);
+	if (bits != 0)
+	{
+		return bn_bin_to_string_pow2(Obj, bits);
+	}
 
-	return res_err;
-}
+	int k = 1;
+	unsigned long long big = radix; // radix^k < 2^64
+	while (big <= ~0ull / radix)
+	{
+		big *= radix;
+		++k;
+	}
 
-/* Функция для суммы двух больших чисел */
-bn* bn_add(bn const* Obj1, bn const* Obj2)
-{
-	if (Obj1 == NULL || Obj2 == NULL)
+	// верхняя оценка числа цифр по количеству бит (с запасом на неполный последний блок)
+	size_t str_size = (size_t)(Obj->size * 64 / log2((double)radix)) + k + 3;
+	char* str = (char*)malloc(str_size * sizeof(char));
+	unsigned long long* arr = (unsigned long long*)malloc(Obj->size * sizeof(unsigned long long));
+	if (str == NULL || arr == NULL)
 	{
+		free(str);
+		free(arr);
 		return NULL;
 	}
 
-	bn* Obj_r = bn_init(Obj1);
+	memcpy(arr, Obj->ptr_body, Obj->size * sizeof(unsigned long long));
+	size_t n = Obj->size;
+	size_t i = 0;
 
-	int code = bn_add_to(Obj_r, Obj2);
-	if (code != BN_OK)
+	// цифры получаются от младших к старшим по k штук за одно деление
+	do
 	{
-		return NULL;
+		unsigned long long curr_mod = bn_bin_limbs_div_1(arr, arr, n, big);
+		for (; n > 1 && arr[n - 1] == 0; --n);
+
+		for (int t = 0; t < k; ++t)
+		{
+			str[i++] = int_to_char((int)(curr_mod % radix));
+			curr_mod /= radix;
+		}
+	} while (n > 1 || arr[0] != 0);
+
+	free(arr);
+
+	for (; i > 1 && str[i - 1] == '0'; --i); // ведущие нули последнего блока
+	if (Obj->sign == -1)
+	{
+		str[i++] = '-';
 	}
+	str[i] = '\0';
 
-	return Obj_r;
+	for (size_t l = 0, r = i - 1; l < r; ++l, --r)
+	{
+		char c = str[l];
+		str[l] = str[r];
+		str[r] = c;
+	}
+
+	return str;
 }
 
-/* Функция для вычитания двух больших чисел */
-bn* bn_sub(bn const* Obj1, bn const* Obj2)
+/* Функция для перевода из BN */
+int bn_bin_from_bn(bn_bin* Obj, bn const* Obj_src)
 {
-	if (Obj1 == NULL || Obj2 == NULL)
+	if (Obj == NULL || Obj_src == NULL)
 	{
-		return NULL;
+		return BN_NULL_OBJECT;
 	}
 
-	bn* Obj_r = bn_init(Obj1);
-
-	int code = bn_sub_to(Obj_r, Obj2);
-	if (code != BN_OK)
+	int res_err = bn_bin_from_limbs(Obj, Obj_src->ptr_body, Obj_src->size);
+	if (res_err != BN_OK)
 	{
-		return NULL;
+		return res_err;
 	}
 
-	return Obj_r;
+	Obj->sign = Obj->sign == 0 ? 0 : Obj_src->sign;
+	return BN_OK;
 }
 
-/* Функиця для вычисления произведения двух больших чисел */
-bn* bn_mul(bn const* Obj1, bn const* Obj2)
+/* Функция для перевода в BN */
+int bn_bin_to_bn(bn* Obj, bn_bin const* Obj_src)
 {
-	if (Obj1 == NULL || Obj2 == NULL)
+	if (Obj == NULL || Obj_src == NULL)
 	{
-		return NULL;
+		return BN_NULL_OBJECT;
 	}
 
-	bn* Obj_r = bn_init(Obj1);
+	unsigned long long* arr = (unsigned long long*)malloc(Obj_src->size * sizeof(unsigned long long));
+	if (arr == NULL)
+	{
+		return BN_NO_MEMORY;
+	}
 
-	int code = bn_mul_to(Obj_r, Obj2);
-	if (code != BN_OK)
+	// за одно деление получается две ячейки BN, а делений не больше 1.08 * size + 1
+	int res_err = bn_reserve(Obj, 3 * Obj_src->size + 2);
+	if (res_err != BN_OK)
 	{
-		return NULL;
+		free(arr);
+		return res_err;
 	}
 
-	return Obj_r;
+	memcpy(arr, Obj_src->ptr_body, Obj_src->size * sizeof(unsigned long long));
+	size_t n = Obj_src->size;
+	size_t i = 0;
+	unsigned long long big = (unsigned long long)NOTATION * NOTATION;
+
+	do
+	{
+		unsigned long long curr_mod = bn_bin_limbs_div_1(arr, arr, n, big);
+		for (; n > 1 && arr[n - 1] == 0; --n);
+
+		Obj->ptr_body[i++] = (int)(curr_mod % NOTATION);
+		Obj->ptr_body[i++] = (int)(curr_mod / NOTATION);
+	} while (n > 1 || arr[0] != 0);
+
+	free(arr);
+
+	Obj->size = i;
+	Obj->sign = Obj_src->sign;
+	return Clean_Nulls_Front(Obj);
 }
 
-/* Функиця для вычисления деления двух больших чисел */
-bn* bn_div(bn const* Obj1, bn const* Obj2)
+/* Функция для сравнивания двух чисел */
+int bn_bin_cmp(bn_bin const* Obj1, bn_bin const* Obj2)
 {
 	if (Obj1 == NULL || Obj2 == NULL)
 	{
-		return NULL;
+		return BN_NULL_OBJECT;
 	}
 
-	bn* Obj_r = bn_init(Obj1);
-
-	int code = bn_div_to(Obj_r, Obj2);
-	if (code != BN_OK)
+	if (Obj1->sign != Obj2->sign)
 	{
-		return NULL;
+		return Obj1->sign > Obj2->sign ? 1 : -1;
+	}
+	if (Obj1->size != Obj2->size)
+	{
+		return Obj1->size > Obj2->size ? Obj1->sign : -Obj1->sign;
 	}
 
-	return Obj_r;
+	return bn_bin_limbs_cmp(Obj1->ptr_body, Obj2->ptr_body, Obj1->size) * Obj1->sign;
 }
 
-/* Функиця для вычисления остатка от деления двух больших чисел */
-bn* bn_mod(bn const* Obj1, bn const* Obj2)
+/* Функция для смены знака */
+int bn_bin_neg(bn_bin* Obj)
 {
-	if (Obj1 == NULL || Obj2 == NULL)
+	if (Obj == NULL)
 	{
-		return NULL;
+		return BN_NULL_OBJECT;
 	}
 
-	bn* Obj_r = bn_init(Obj1);
+	Obj->sign = -Obj->sign;
+	return BN_OK;
+}
 
-	int code = bn_mod_to(Obj_r, Obj2);
-	if (code != BN_OK)
+/* Функция для взятия модуля */
+int bn_bin_abs(bn_bin* Obj)
+{
+	if (Obj == NULL)
 	{
-		return NULL;
+		return BN_NULL_OBJECT;
 	}
 
-	return Obj_r;
+	Obj->sign = Obj->sign != 0;
+	return BN_OK;
 }
 
-/* Функция для предстваления BN в некоторой системе счисления radix в виде строки */
-char* bn_to_string(bn const* Obj, int radix)
+/* Функция, возвращающая информацию о знаке */
+int bn_bin_sign(bn_bin const* Obj)
 {
 	if (Obj == NULL)
 	{
-		return NULL;
-	}
-	if (radix <= 0)
-	{
-		printf("\nПроверьте корректность поставляемых данных.\n");
-		return NULL;
+		return BN_NULL_OBJECT;
 	}
-	if (Obj->sign == 0)
-	{
-		char* str_r = (char*)malloc(2 * sizeof(char));
-		if (str_r == NULL)
-		{
-			return NULL;
-		}
 
-		str_r[0] = '0';
-		str_r[1] = '\0';
-		return str_r;
-	}
+	return Obj->sign;
+}
 
-	bn* Obj_c = bn_init(Obj);
+/* Функция для прибавления одного числа к другому */
+int bn_bin_add_to(bn_bin* Obj1, bn_bin const* Obj2)
+{
+	return bn_bin_add_signed(Obj1, Obj2, 0);
+}
 
-	int str_size = 10;
-	size_t i = 0;
-	size_t ind_minus = 0;
+/* Функция для вычитания из одного числа другого */
+int bn_bin_sub_to(bn_bin* Obj1, bn_bin const* Obj2)
+{
+	return bn_bin_add_signed(Obj1, Obj2, 1);
+}
 
-	char* str = (char*)malloc(str_size * sizeof(char));
-	for (size_t j = 0; j < str_size; ++j)
+/* Функция для умножения одного числа на другое */
+int bn_bin_mul_to(bn_bin* Obj1, bn_bin const* Obj2)
+{
+	if (Obj1 == NULL || Obj2 == NULL)
 	{
-		str[j] = '\0';
+		return BN_NULL_OBJECT;
 	}
-	if (Obj->sign == -1)
+	if (Obj1->sign == 0 || Obj2->sign == 0)
 	{
-		str[i] = '-';
-		++i;
-		++ind_minus;
+		Obj1->size = 1;
+		Obj1->ptr_body[0] = 0;
+		Obj1->sign = 0;
+		return BN_OK;
 	}
 
-	int curr_mod = 0;
-	while (Obj_c->sign != 0)
-	{
-		curr_mod = bn_div_int(Obj_c, radix);
+	size_t n_r = Obj1->size + Obj2->size; // длина произведения
+	size_t n_max = Obj1->size < Obj2->size ? Obj2->size : Obj1->size;
+	size_t n_tmp = bn_limbs_karatsuba_scratch(n_max);
 
-		str[i++] = int_to_char(curr_mod);
-		if (i == str_size - 1)
-		{
-			str_size *= 2;
-			str = (char*)realloc(str, str_size * sizeof(int));
-			for (size_t j = i + 1; j < str_size; ++j)
-			{
-				str[j] = '\0';
-			}
-		}
+	unsigned long long* res = (unsigned long long*)malloc(n_r * sizeof(unsigned long long)); // произведение
+	unsigned long long* tmp = (unsigned long long*)malloc((n_tmp + 1) * sizeof(unsigned long long)); // рабочая память
+	if (res == NULL || tmp == NULL)
+	{
+		free(res);
+		free(tmp);
+		return BN_NO_MEMORY;
 	}
 
-	bn_delete(Obj_c);
-
-	str = (char*)realloc(str, (i + 1) * sizeof(char));
-
-	char* left = str + ind_minus;
-	char* right = str + i - 1;
+	bn_bin_limbs_mul_karatsuba(res, Obj1->ptr_body, Obj1->size, Obj2->ptr_body, Obj2->size, tmp);
+	free(tmp);
 
-	char c;
-	while (left < right)
-	{
-		c = *left;
-		*(left++) = *right;
-		*(right--) = c;
-	}
+	free(Obj1->ptr_body);
+	Obj1->ptr_body = res;
+	Obj1->capacity = n_r;
+	Obj1->size = n_r;
+	Obj1->sign *= Obj2->sign;
+	bn_bin_normalize(Obj1);
 
-	return str;
+	return BN_OK;
 }
 
-// -------------------------------------- ОПРЕДЕЛЕНИЯ ДОПОЛНИТЕЛЬНЫХ ФУНКЦИЙ -------------------------------------------
-int char_to_int(char character)
+/* Функция для нахождения частного (с округлением вниз) и остатка за одно деление */
+int bn_bin_divmod(bn_bin* Obj_q, bn_bin* Obj_r, bn_bin const* Obj1, bn_bin const* Obj2)
 {
-	if (isdigit(character)) // если символ от 0 до 9
+	if (Obj1 == NULL || Obj2 == NULL || (Obj_q == NULL && Obj_r == NULL))
 	{
-		return character - '0';
+		return BN_NULL_OBJECT;
 	}
-	if (isupper(character))
+	if (Obj2->sign == 0)
 	{
-		return character - 'A' + 10;
+		return BN_DIVIDE_BY_ZERO;
 	}
-	if (islower(character))
+
+	int sign1 = Obj1->sign, sign2 = Obj2->sign;
+	size_t na = Obj1->size, nb = Obj2->size;
+	size_t n_q = na >= nb ? na - nb + 1 : 1; // длина частного
+
+	// результаты собираются во временных массивах: q и r могут совпадать с операндами
+	unsigned long long* q = (unsigned long long*)calloc(n_q + 1, sizeof(unsigned long long));
+	unsigned long long* r = (unsigned long long*)calloc(nb, sizeof(unsigned long long));
+	if (q == NULL || r == NULL)
 	{
-		return character - 'a' + 10;
+		free(q);
+		free(r);
+		return BN_NO_MEMORY;
 	}
-	return BN_OK;
-}
 
-char int_to_char(int number)
-{
-	if (number < 10)
+	if (na < nb || (na == nb && bn_bin_limbs_cmp(Obj1->ptr_body, Obj2->ptr_body, na) < 0))
 	{
-		return number + '0';
+		memcpy(r, Obj1->ptr_body, na * sizeof(unsigned long long));
 	}
-	return number + 'A' - 10;
-}
-int bn_mul_int(bn* Obj, int number)
-{
-	if (Obj == NULL)
+	else if (bn_bin_limbs_divrem(q, r, Obj1->ptr_body, na, Obj2->ptr_body, nb) != BN_OK)
 	{
-		return BN_NULL_OBJECT;
+		free(q);
+		free(r);
+		return BN_NO_MEMORY;
 	}
 
-	if (Obj->sign == 0 || number == 1)
+	size_t i = 0;
+	for (; i < nb && r[i] == 0; ++i);
+	int r_zero = i == nb;
+
+	// при разных знаках и ненулевом остатке: |q| = Q + 1, |r| = |b| - R
+	if (sign1 * sign2 == -1 && !r_zero)
 	{
-		return BN_OK;
+		const unsigned long long one = 1;
+		bn_bin_limbs_add_to(q, n_q + 1, &one, 1);
+		bn_bin_limbs_sub(r, Obj2->ptr_body, nb, r, nb);
 	}
-	if (number == -1)
+
+	if (Obj_q != NULL)
 	{
-		return bn_abs(Obj);
+		free(Obj_q->ptr_body);
+		Obj_q->ptr_body = q;
+		Obj_q->capacity = n_q + 1;
+		Obj_q->size = n_q + 1;
+		Obj_q->sign = sign1 * sign2;
+		bn_bin_normalize(Obj_q);
 	}
-	if (number == 0)
+	else
 	{
-		bn* Obj_null = bn_new();
-		int res_ass = Analog_assignment(Obj, Obj_null);
-		bn_delete(Obj_null);
-
-		return res_ass;
+		free(q);
 	}
 
-	bn* Obj_mul = bn_new();
-	int res_init = bn_init_int(Obj_mul, number);
-	if (res_init != BN_OK)
+	if (Obj_r != NULL)
 	{
-		return res_init;
+		free(Obj_r->ptr_body);
+		Obj_r->ptr_body = r;
+		Obj_r->capacity = nb;
+		Obj_r->size = nb;
+		Obj_r->sign = sign2;
+		bn_bin_normalize(Obj_r);
 	}
-
-	int res_mul = bn_mul_to(Obj, Obj_mul);
-	if (res_mul != BN_OK)
+	else
 	{
-		return res_mul;
+		free(r);
 	}
 
-	bn_delete(Obj_mul);
+	return BN_OK;
+}
 
-	return res_mul;
+/* Функция для деления одного числа на другое (с округлением вниз) */
+int bn_bin_div_to(bn_bin* Obj1, bn_bin const* Obj2)
+{
+	return bn_bin_divmod(Obj1, NULL, Obj1, Obj2);
 }
 
-int bn_add_to_abs_int(bn* Obj, int number)
+/* Функция для взятия остатка */
+int bn_bin_mod_to(bn_bin* Obj1, bn_bin const* Obj2)
 {
-	if (Obj == NULL)
-	{
-		return BN_NULL_OBJECT;
-	}
-	if (number == 0)
+	return bn_bin_divmod(NULL, Obj1, Obj1, Obj2);
+}
+
+int bn_bin_grow(bn_bin* Obj, size_t newcap)
+{
+	if (Obj->capacity >= newcap)
 	{
 		return BN_OK;
 	}
 
-	bn* Obj_add = bn_new();
-	int res_init = bn_init_int(Obj_add, number);
-	if (res_init != BN_OK)
-	{
-		return res_init;
-	}
+	size_t cap = Obj->capacity + Obj->capacity / 2;
+	return bn_bin_reserve(Obj, cap < newcap ? newcap : cap);
+}
 
-	int res_mul = bn_add_to(Obj, Obj_add);
-	if (res_mul != BN_OK)
+void bn_bin_normalize(bn_bin* Obj)
+{
+	for (; Obj->size > 1 && Obj->ptr_body[Obj->size - 1] == 0; --Obj->size);
+	if (Obj->size == 1 && Obj->ptr_body[0] == 0)
 	{
-		return res_mul;
+		Obj->sign = 0;
 	}
-
-	bn_delete(Obj_add);
-
-	return BN_OK;
 }
 
-int bn_div_int(bn* Obj, long long number)
+int bn_bin_add_signed(bn_bin* Obj1, bn_bin const* Obj2, int negate)
 {
-	if (Obj == NULL)
+	if (Obj1 == NULL || Obj2 == NULL)
 	{
 		return BN_NULL_OBJECT;
 	}
-	if (number == 0)
+
+	int sign2 = negate ? -Obj2->sign : Obj2->sign; // знак второго слагаемого
+	if (sign2 == 0)
 	{
-		return BN_DIVIDE_BY_ZERO;
+		return BN_OK;
 	}
-
-	long long curr_div = 0,
-			  curr_mod = 0;
-
-	for (int i = Obj->size - 1; i >= 0; --i)
+	if (Obj1->sign == 0)
 	{
-		curr_div = NOTATION * curr_mod + Obj->ptr_body[i];
-
-		Obj->ptr_body[i] = curr_div / number;
-		curr_mod = curr_div - Obj->ptr_body[i] * number;
+		int res_err = bn_bin_assign(Obj1, Obj2);
+		Obj1->sign = sign2;
+		return res_err;
 	}
 
-	int res_err = Clean_Nulls_Front(Obj);
+	size_t n1 = Obj1->size, n2 = Obj2->size;
+	int res_err = bn_bin_grow(Obj1, (n1 > n2 ? n1 : n2) + 1);
 	if (res_err != BN_OK)
 	{
 		return res_err;
 	}
 
-	return curr_mod;
-}
+	unsigned long long* a = Obj1->ptr_body;
+	const unsigned long long* b = Obj2->ptr_body; // после роста Obj1, на случай Obj1 == Obj2
 
-int Analog_assignment(bn* Obj1, bn* Obj2)
-{
-	if (Obj1 == NULL || Obj2 == NULL)
+	if (Obj1->sign == sign2) // сложение модулей
 	{
-		return BN_NULL_OBJECT;
+		if (n1 >= n2)
+		{
+			a[n1] = bn_bin_limbs_add(a, a, n1, b, n2);
+		}
+		else
+		{
+			a[n2] = bn_bin_limbs_add(a, b, n2, a, n1);
+		}
+		Obj1->size = (n1 > n2 ? n1 : n2) + 1;
 	}
-
-	Obj1->sign = Obj2->sign;
-
-	if (Obj1->ptr_body != NULL)
+	else // вычитание меньшего модуля из большего
 	{
-		free(Obj1->ptr_body);
-		Obj1->ptr_body = NULL;
+		int param_res = n1 != n2 ? (n1 > n2 ? 1 : -1) : bn_bin_limbs_cmp(a, b, n1);
+		if (param_res >= 0)
+		{
+			bn_bin_limbs_sub(a, a, n1, b, n2);
+		}
+		else
+		{
+			bn_bin_limbs_sub(a, b, n2, a, n1);
+			Obj1->size = n2;
+			Obj1->sign = sign2;
+		}
 	}
 
-	Obj1->ptr_body = (int*)malloc(sizeof(int) * Obj2->size);
-	if (Obj1->ptr_body == NULL)
-	{
-		return BN_NO_MEMORY;
+	bn_bin_normalize(Obj1);
+	return BN_OK;
+}
+
+unsigned long long bn_bin_mul_64(unsigned long long a, unsigned long long b, unsigned long long* hi)
+{
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 curr = (unsigned __int128)a * b;
+	*hi = (unsigned long long)(curr >> 64);
+	return (unsigned long long)curr;
+#else
+	// четыре произведения 32-битных половин, каждое помещается в 64 бита
+	const unsigned long long mask = 0xFFFFFFFFull;
+	unsigned long long a0 = a & mask, a1 = a >> 32, b0 = b & mask, b1 = b >> 32;
+	unsigned long long p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+
+	unsigned long long mid = (p00 >> 32) + (p01 & mask) + (p10 & mask); // < 3 * 2^32
+	*hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+	return (mid << 32) | (p00 & mask);
+#endif
+}
+
+unsigned long long bn_bin_div_128(unsigned long long hi, unsigned long long lo, unsigned long long d, unsigned long long* rem)
+{
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 curr = ((unsigned __int128)hi << 64) | lo;
+	unsigned long long q = (unsigned long long)(curr / d);
+	*rem = (unsigned long long)(curr - (unsigned __int128)q * d);
+	return q;
+#else
+	// деление Кнута по 32-битным цифрам: делитель сдвигается так, чтобы старший бит стал единичным
+	const unsigned long long base = 1ull << 32;
+	int s = bn_bin_clz(d);
+	d <<= s;
+	unsigned long long d1 = d >> 32, d0 = d & (base - 1);
+	unsigned long long u32 = s ? (hi << s) | (lo >> (64 - s)) : hi;
+	unsigned long long u10 = lo << s;
+	unsigned long long u1 = u10 >> 32, u0 = u10 & (base - 1);
+
+	// старшая цифра частного
+	unsigned long long q1 = u32 / d1, r_hat = u32 - q1 * d1;
+	while (q1 >= base || q1 * d0 > r_hat * base + u1)
+	{
+		--q1;
+		r_hat += d1;
+		if (r_hat >= base)
+		{
+			break;
+		}
 	}
+	unsigned long long u21 = u32 * base + u1 - q1 * d; // остаток меньше d, вычисления по модулю 2^64 точны
 
-	for (size_t i = 0; i < Obj2->size; ++i)
+	// младшая цифра частного
+	unsigned long long q0 = u21 / d1;
+	r_hat = u21 - q0 * d1;
+	while (q0 >= base || q0 * d0 > r_hat * base + u0)
 	{
-		Obj1->ptr_body[i] = Obj2->ptr_body[i];
+		--q0;
+		r_hat += d1;
+		if (r_hat >= base)
+		{
+			break;
+		}
 	}
 
-	Obj1->size = Obj2->size;
-
-	return BN_OK;
+	*rem = (u21 * base + u0 - q0 * d) >> s;
+	return q1 * base + q0;
+#endif
 }
 
-/* Функция для разности двух модулей */
-int Sub_Abs(bn* Obj1, bn const* Obj2) {
-	if (Obj1 == NULL || Obj2 == NULL)
+int bn_bin_clz(unsigned long long num)
+{
+#if defined(__GNUC__)
+	return __builtin_clzll(num);
+#else
+	int count = 0;
+	for (; !(num >> 63); num <<= 1)
 	{
-		return BN_NO_MEMORY;
+		++count;
 	}
+	return count;
+#endif
+}
 
-	int flag = 0; // параметр, сигнализирующий, о получении слишком маленького числа в ячейке
+unsigned long long bn_bin_limbs_add(unsigned long long* r, const unsigned long long* a, size_t na, const unsigned long long* b, size_t nb)
+{
+	unsigned long long flag = 0; // перенос
 	size_t i = 0;
 
-	for (; i < Obj1->size || flag != 0; ++i) {
-		Obj1->ptr_body[i] -= flag + (i < Obj2->size ? Obj2->ptr_body[i] : 0);
-		flag = Obj1->ptr_body[i] < 0;
-
-		if (flag != 0)
-		{
-			Obj1->ptr_body[i] += NOTATION;
-		}
+	for (; i < nb; ++i)
+	{
+		unsigned long long curr = a[i] + flag;
+		flag = curr < flag;
+		curr += b[i];
+		flag += curr < b[i];
+		r[i] = curr;
+	}
+	for (; i < na; ++i)
+	{
+		r[i] = a[i] + flag;
+		flag = r[i] < flag;
 	}
 
-	return Clean_Nulls_Front(Obj1);
+	return flag;
 }
 
-/* Функция для школьного перемножения */
-int bn_mul_col(bn* Obj1, bn const* Obj2)
+unsigned long long bn_bin_limbs_sub(unsigned long long* r, const unsigned long long* a, size_t na, const unsigned long long* b, size_t nb)
 {
-	if (Obj1 == NULL || Obj2 == NULL)
-	{
-		return BN_OK;
-	}
-
-	int res_err;
-	bn* Obj_r = bn_new();
+	unsigned long long flag = 0; // заем
+	size_t i = 0;
 
-	if (Obj1->sign == 0 || Obj2->sign == 0)
+	for (; i < nb; ++i)
 	{
-		res_err =  Analog_assignment(Obj1, Obj_r);
-		bn_delete(Obj_r);
-		return res_err;
+		unsigned long long ai = a[i], bi = b[i];
+		unsigned long long curr = ai - bi - flag;
+		flag = (ai < bi) | (ai == bi && flag);
+		r[i] = curr;
 	}
-
-	int res_add = bn_add_nulls_begin(Obj_r, Obj1->size + Obj2->size);
-	if (res_add != BN_OK)
+	for (; i < na; ++i)
 	{
-		return res_add;
+		unsigned long long ai = a[i];
+		r[i] = ai - flag;
+		flag = ai < flag;
 	}
 
-	Obj_r->sign = Obj1->sign * Obj2->sign;
+	return flag;
+}
 
-	int flag;
-	long long curr;
+unsigned long long bn_bin_limbs_add_to(unsigned long long* r, size_t nr, const unsigned long long* a, size_t na)
+{
+	unsigned long long flag = bn_bin_limbs_add(r, r, na, a, na);
 
-	for (size_t i = 0; i < Obj1->size; ++i)
+	for (size_t i = na; flag != 0 && i < nr; ++i)
 	{
-		flag = 0; // флаг переноса
+		flag = ++r[i] == 0;
+	}
+
+	return flag;
+}
 
-		for (size_t j = 0; j < Obj2->size || flag != 0; ++j)
+int bn_bin_limbs_cmp(const unsigned long long* a, const unsigned long long* b, size_t n)
+{
+	for (size_t i = n; i-- > 0;)
+	{
+		if (a[i] != b[i])
 		{
-			curr = (long long)Obj_r->ptr_body[i + j] + flag + (long long)Obj1->ptr_body[i] * (j < Obj2->size ? Obj2->ptr_body[j] : 0);
-			flag = (int)(curr / NOTATION);
-			Obj_r->ptr_body[i + j] = (int)(curr % NOTATION);
+			return a[i] > b[i] ? 1 : -1;
 		}
 	}
+	return 0;
+}
+
+unsigned long long bn_bin_limbs_mul_1(unsigned long long* r, const unsigned long long* a, size_t n, unsigned long long d)
+{
+	unsigned long long flag = 0; // перенос
 
-	int res_cl = Clean_Nulls_Front(Obj_r);
-	if (res_cl != BN_OK)
+	for (size_t i = 0; i < n; ++i)
 	{
-		return res_cl;
+		unsigned long long hi = 0;
+		unsigned long long lo = bn_bin_mul_64(a[i], d, &hi) + flag;
+		r[i] = lo;
+		flag = hi + (lo < flag);
 	}
 
-	res_err = Analog_assignment(Obj1, Obj_r);
-	bn_delete(Obj_r);
-	return res_err;
+	return flag;
 }
 
-bn* bn_pow(bn const* Obj, int degree)
+unsigned long long bn_bin_limbs_submul_1(unsigned long long* r, const unsigned long long* a, size_t n, unsigned long long d)
 {
-	if (Obj == NULL)
+	unsigned long long flag = 0; // заем
+
+	for (size_t i = 0; i < n; ++i)
 	{
-		return NULL;
+		unsigned long long hi = 0;
+		unsigned long long sub = bn_bin_mul_64(a[i], d, &hi) + flag;
+		flag = hi + (sub < flag) + (r[i] < sub);
+		r[i] -= sub;
 	}
 
-	bn* Obj_r = bn_init(Obj);
+	return flag;
+}
 
-	int code = bn_pow_to(Obj_r, degree);
-	if (code != BN_OK)
+unsigned long long bn_bin_limbs_div_1(unsigned long long* q, const unsigned long long* a, size_t n, unsigned long long d)
+{
+	unsigned long long curr_mod = 0;
+
+	for (size_t i = n; i-- > 0;)
 	{
-		return NULL;
+		q[i] = bn_bin_div_128(curr_mod, a[i], d, &curr_mod);
 	}
 
-	return Obj_r;
+	return curr_mod;
 }
 
-int bn_add_nulls_begin(bn* Obj, size_t newsize)
+void bn_bin_limbs_mul_basecase(unsigned long long* r, const unsigned long long* a, size_t na, const unsigned long long* b, size_t nb)
 {
-	if (Obj == NULL)
+	memset(r, 0, (na + nb) * sizeof(unsigned long long));
+
+	for (size_t i = 0; i < na; ++i)
 	{
-		return BN_NULL_OBJECT;
+		unsigned long long flag = 0; // перенос
+
+		for (size_t j = 0; j < nb; ++j)
+		{
+			// a[i] * b[j] + r[i + j] + flag < 2^128
+			unsigned long long hi = 0;
+			unsigned long long lo = bn_bin_mul_64(a[i], b[j], &hi) + r[i + j];
+			hi += lo < r[i + j];
+			lo += flag;
+			r[i + j] = lo;
+			flag = hi + (lo < flag);
+		}
+		r[i + nb] = flag;
 	}
-	if (Obj->size > newsize)
+}
+
+void bn_bin_limbs_mul_karatsuba(unsigned long long* r, const unsigned long long* a, size_t na, const unsigned long long* b, size_t nb, unsigned long long* tmp)
+{
+	if (na < nb)
 	{
-		return BN_NO_MEMORY;
+		const unsigned long long* t = a; a = b; b = t;
+		size_t n = na; na = nb; nb = n;
 	}
-	if (Obj->size == newsize)
+	if (nb < BN_KARATSUBA_THRESHOLD)
 	{
-		return BN_OK;
+		bn_bin_limbs_mul_basecase(r, a, na, b, nb);
+		return;
 	}
 
-	Obj->ptr_body = (int*)realloc(Obj->ptr_body, newsize * sizeof(int));
-	if (Obj->ptr_body == NULL)
-	{
-		return BN_NO_MEMORY;
-	}
+	size_t m = (na + 1) / 2; // длина младшей половины: a = a1 * 2^(64m) + a0
+	size_t h = na - m; // длина старшей половины a
 
-	for (size_t i = Obj->size; i < newsize; ++i)
+	if (nb <= m) // множители несбалансированы: a0 * b и a1 * b считаются отдельно
 	{
-		Obj->ptr_body[i] = 0;
+		unsigned long long* t = tmp; // a1 * b, h + nb ячеек
+		bn_bin_limbs_mul_karatsuba(r, a, m, b, nb, tmp);
+		memset(r + m + nb, 0, h * sizeof(unsigned long long));
+		bn_bin_limbs_mul_karatsuba(t, a + m, h, b, nb, tmp + h + nb);
+		bn_bin_limbs_add_to(r + m, na + nb - m, t, h + nb);
+		return;
 	}
 
-	Obj->size = newsize;
-	return BN_OK;
+	size_t hb = nb - m; // длина старшей половины b
+	unsigned long long* sa = tmp; // a0 + a1, m + 1 ячеек
+	unsigned long long* sb = tmp + m + 1; // b0 + b1, m + 1 ячеек
+	unsigned long long* z1 = tmp + 2 * m + 2; // (a0 + a1) * (b0 + b1), 2m + 2 ячеек
+	unsigned long long* rest = tmp + 4 * m + 4;
+
+	sa[m] = bn_bin_limbs_add(sa, a, m, a + m, h);
+	sb[m] = bn_bin_limbs_add(sb, b, m, b + m, hb);
+
+	bn_bin_limbs_mul_karatsuba(z1, sa, m + 1, sb, m + 1, rest);
+	bn_bin_limbs_mul_karatsuba(r, a, m, b, m, rest); // z0 = a0 * b0
+	bn_bin_limbs_mul_karatsuba(r + 2 * m, a + m, h, b + m, hb, rest); // z2 = a1 * b1
+
+	// z1 = z1 - z0 - z2 = a0 * b1 + a1 * b0
+	bn_bin_limbs_sub(z1, z1, 2 * m + 2, r, 2 * m);
+	bn_bin_limbs_sub(z1, z1, 2 * m + 2, r + 2 * m, h + hb);
+
+	size_t nz = 2 * m + 2;
+	for (; nz > 0 && z1[nz - 1] == 0; --nz);
+	bn_bin_limbs_add_to(r + m, na + nb - m, z1, nz);
 }
 
-int Clean_Nulls_Front(bn* Obj)
+int bn_bin_limbs_divrem(unsigned long long* q, unsigned long long* r, const unsigned long long* a, size_t na, const unsigned long long* b, size_t nb)
 {
-	if (Obj == NULL)
+	if (nb == 1)
 	{
-		return BN_NULL_OBJECT;
+		unsigned long long curr_mod = bn_bin_limbs_div_1(q, a, na, b[0]);
+		if (r != NULL)
+		{
+			r[0] = curr_mod;
+		}
+		return BN_OK;
 	}
 
-	int i = Obj->size - 1;
-	for (; Obj->ptr_body[i] == 0 && i > 0; --i);
-	if (Obj->ptr_body[i] == 0)
+	unsigned long long* un = (unsigned long long*)malloc((na + 1 + nb) * sizeof(unsigned long long)); // нормализованное делимое
+	if (un == NULL)
 	{
-		--i;
+		return BN_NO_MEMORY;
 	}
+	unsigned long long* vn = un + na + 1; // нормализованный делитель
 
-	if (i == -1)
+	// нормализация сдвигом: старший бит делителя становится единичным
+	int s = bn_bin_clz(b[nb - 1]);
+	for (size_t i = nb - 1; i > 0; --i)
 	{
-		free(Obj->ptr_body);
-		Obj->ptr_body = (int*)calloc(1, sizeof(int));
-		Obj->size = 1;
-		Obj->sign = 0;
-
-		return BN_OK;
+		vn[i] = s ? (b[i] << s) | (b[i - 1] >> (64 - s)) : b[i];
 	}
+	vn[0] = b[0] << s;
 
-	Obj->ptr_body = (int*)realloc(Obj->ptr_body, (i + 1) * sizeof(int));
-	if (Obj->ptr_body == NULL)
+	un[na] = s ? a[na - 1] >> (64 - s) : 0;
+	for (size_t i = na - 1; i > 0; --i)
 	{
-		return BN_NO_MEMORY;
+		un[i] = s ? (a[i] << s) | (a[i - 1] >> (64 - s)) : a[i];
 	}
+	un[0] = a[0] << s;
 
-	Obj->size = i + 1;
+	unsigned long long v1 = vn[nb - 1], v2 = vn[nb - 2];
 
-	return BN_OK;
-}
-
-int bn_abs_cmp(bn const* Obj1, bn const* Obj2)
-{
-	if (Obj1 == NULL || Obj2 == NULL)
+	for (size_t j = na - nb + 1; j-- > 0;)
 	{
-		return BN_NULL_OBJECT;
-	}
-
-	if (Obj1->size != Obj2->size) {
-		int param_res0 = 0;
-		if (Obj1->size > Obj2->size)
+		// оценка очередной ячейки частного по двум старшим ячейкам остатка (старшая не больше v1)
+		unsigned long long q_hat = 0, r_hat = 0;
+		bool r_over = false; // r_hat >= 2^64: уточнение не нужно
+		if (un[j + nb] >= v1)
 		{
-			param_res0 = 1;
+			q_hat = ~0ull;
+			r_hat = un[j + nb - 1] + v1;
+			r_over = r_hat < v1;
 		}
-		else if (Obj1->size < Obj2->size)
+		else
 		{
-			param_res0 = -1;
+			q_hat = bn_bin_div_128(un[j + nb], un[j + nb - 1], v1, &r_hat);
 		}
 
-		return param_res0 * Obj1->sign;
-	}
-	else // размеры равны
-	{
-		int param_res = 0;
-		for (int i = Obj1->size - 1; i >= 0; --i)
+		// уточнение по третьей ячейке: пока q_hat * v2 > r_hat * 2^64 + un[j + nb - 2]
+		while (!r_over)
 		{
-			if (Obj1->ptr_body[i] > Obj2->ptr_body[i])
+			unsigned long long p_hi = 0;
+			unsigned long long p_lo = bn_bin_mul_64(q_hat, v2, &p_hi);
+			if (p_hi < r_hat || (p_hi == r_hat && p_lo <= un[j + nb - 2]))
 			{
-				param_res = 1;
-				break;
-			}
-			else if (Obj1->ptr_body[i] < Obj2->ptr_body[i])
-			{
-				param_res = -1;
 				break;
 			}
+
+			--q_hat;
+			r_hat += v1;
+			r_over = r_hat < v1;
 		}
 
-		return param_res * Obj1->sign;
-	}
-}
+		unsigned long long flag = bn_bin_limbs_submul_1(un + j, vn, nb, (unsigned long long)q_hat);
+		unsigned long long top = un[j + nb];
+		un[j + nb] = top - flag;
 
-int bn_shift_right(bn* Obj)
-{
-	if (Obj == NULL)
-	{
-		return BN_NULL_OBJECT;
+		if (top < flag) // оценка оказалась на 1 больше: возвращаем делитель
+		{
+			--q_hat;
+			un[j + nb] += bn_bin_limbs_add(un + j, un + j, nb, vn, nb);
+		}
+
+		q[j] = q_hat;
 	}
 
-	int* arr = (int*)realloc(Obj->ptr_body, (Obj->size + 1) * sizeof(int));
-	if (arr == NULL)
+	if (r != NULL) // денормализация остатка
 	{
-		return BN_NO_MEMORY;
+		for (size_t i = 0; i < nb; ++i)
+		{
+			r[i] = s ? (un[i] >> s) | (un[i + 1] << (64 - s)) : un[i];
+		}
 	}
 
-	arr[Obj->size] = 0;
-	++Obj->size;
+	free(un);
+	return BN_OK;
+}
+
+// кэш степеней NOTATION^(2^level), общий для всех вызовов (очищается в bn_cache_clear)
+#ifdef BN_CACHE_ATOMIC
+bn_cache_slot bn_bin_notation_powers[BN_RADIX_LEVELS];
+#elif defined(_MSC_VER)
+__declspec(thread) bn_cache_slot bn_bin_notation_powers[BN_RADIX_LEVELS];
+#else
+_Thread_local bn_cache_slot bn_bin_notation_powers[BN_RADIX_LEVELS];
+#endif
 
-	for (size_t i = Obj->size - 1; i > 0; --i)
+int bn_bin_radix_bits(int radix)
+{
+	if ((radix & (radix - 1)) != 0)
 	{
-		arr[i] = arr[i - 1];
+		return 0;
 	}
-	arr[0] = 0;
-
-	Obj->ptr_body = NULL;
-	Obj->ptr_body = arr;
 
-	int res_err = Clean_Nulls_Front(Obj);
+	int bits = 0;
+	for (; (1 << bits) < radix; ++bits);
 
-	return res_err;
+	return bits;
 }
 
-int PrintFibo(int num)
+char* bn_bin_to_string_pow2(bn_bin const* Obj, int bits)
 {
-	if (num < 1)
+	// количество значащих бит
+	size_t n_bits = 64 * (Obj->size - 1);
+	for (unsigned long long top = Obj->ptr_body[Obj->size - 1]; top != 0; top >>= 1)
 	{
-		printf("Проверьте корректность введенных данных.\n");
-		return BN_OK;
-	}
-	if (num == 1 || num == 2)
-	{
-		printf("1");
-		return BN_OK;
+		++n_bits;
 	}
 
-	bn* Obj1 = bn_new();
-	Obj1->sign = 1;
-	Obj1->ptr_body[0] = 1;
+	size_t n_digits = n_bits == 0 ? 1 : (n_bits + bits - 1) / bits;
+	size_t ind_minus = (Obj->sign == -1);
 
-	bn* Obj2 = bn_new();
-	Obj2->sign = 1;
-	Obj2->ptr_body[0] = 1;
+	char* str = (char*)malloc((ind_minus + n_digits + 1) * sizeof(char));
+	if (str == NULL)
+	{
+		return NULL;
+	}
 
-	int res_err;
+	if (ind_minus)
+	{
+		str[0] = '-';
+	}
+	str[ind_minus + n_digits] = '\0';
 
-	int j = 2;
-	for (; j < num; ++j)
+	// i-я с конца цифра - биты [i * bits, (i + 1) * bits), группа может попасть на границу ячеек
+	unsigned long long mask = (1ull << bits) - 1;
+	char* curr = str + ind_minus + n_digits;
+	for (size_t i = 0, pos = 0; i < n_digits; ++i, pos += bits)
 	{
-		if (j % 2 == 0)
-		{
-			res_err = bn_add_to(Obj1, Obj2);
-			if (res_err != BN_OK)
-			{
-				return res_err;
-			}
-		}
-		else
+		size_t word = pos / 64;
+		size_t shift = pos % 64;
+
+		unsigned long long digit = Obj->ptr_body[word] >> shift;
+		if (shift + bits > 64 && word + 1 < Obj->size)
 		{
-			res_err = bn_add_to(Obj2, Obj1);
-			if (res_err != BN_OK)
-			{
-				return res_err;
-			}
+			digit |= Obj->ptr_body[word + 1] << (64 - shift);
 		}
+
+		*(--curr) = int_to_char((int)(digit & mask));
 	}
 
-	if (j % 2 == 0)
-	{
-		bn_delete(Obj1);
-		
-		for (int i = Obj2->size - 1; i != -1; --i) {
-			if (i != Obj2->size - 1 && Obj2->ptr_body[i] != 0)
-			{
-				int el_size = (int)ceil(log10(Obj2->ptr_body[i]));
-				if ((el_size < NUM))
-				{
-					for (int j = 0; j < NUM - el_size; ++j)
-					{
-						printf("0");
-					}
-				}
-				printf("%d", Obj2->ptr_body[i]);
-			}
-			else if (i == Obj2->size - 1)
-			{
-				printf("%d", Obj2->ptr_body[i]);
-			}
-			else if (i == 0 && Obj2->ptr_body[i] == 0)
-			{
-				printf("%d", 0);
-			}
-			else // i != 0 && i != Obj->size - 1 && Obj->ptr_body[i] = 0
-			{
-				for (int i = 0; i < NUM; ++i)
-				{
-					printf("%d", 0);
-				}
-			}
-		}
+	return str;
+}
+
+int bn_bin_init_string_pow2(bn_bin* Obj, const char* str, size_t length, int bits)
+{
+	size_t n = (length * bits + 63) / 64;
 
-		bn_delete(Obj2);
+	int res_err = bn_bin_reserve(Obj, n);
+	if (res_err != BN_OK)
+	{
+		return res_err;
 	}
-	else
+	memset(Obj->ptr_body, 0, n * sizeof(unsigned long long));
+
+	// цифры идут с конца строки, каждая занимает ровно bits бит
+	for (size_t i = 0, pos = 0; i < length; ++i, pos += bits)
 	{
-		bn_delete(Obj2);
-		
-		for (int i = Obj1->size - 1; i != -1; --i) {
-			if (i != Obj1->size - 1 && Obj1->ptr_body[i] != 0)
-			{
-				int el_size = (int)ceil(log10(Obj1->ptr_body[i]));
-				if ((el_size < NUM))
-				{
-					for (int j = 0; j < NUM - el_size; ++j)
-					{
-						printf("0");
-					}
-				}
-				printf("%d", Obj1->ptr_body[i]);
-			}
-			else if (i == Obj1->size - 1)
-			{
-				printf("%d", Obj1->ptr_body[i]);
-			}
-			else if (i == 0 && Obj1->ptr_body[i] == 0)
-			{
-				printf("%d", 0);
-			}
-			else // i != 0 && i != Obj->size - 1 && Obj->ptr_body[i] = 0
-			{
-				for (int i = 0; i < NUM; ++i)
-				{
-					printf("%d", 0);
-				}
-			}
-		}
+		unsigned long long digit = (unsigned long long)char_to_int(str[length - 1 - i]);
+		size_t word = pos / 64;
+		size_t shift = pos % 64;
 
-		bn_delete(Obj1);
+		Obj->ptr_body[word] |= digit << shift;
+		if (shift + bits > 64)
+		{
+			Obj->ptr_body[word + 1] |= digit >> (64 - shift);
+		}
 	}
 
+	Obj->size = n;
+	Obj->sign = 1;
+	bn_bin_normalize(Obj);
+
 	return BN_OK;
 }
 
-bn* bn_sqrt(bn const* Obj)
+bn_bin const* bn_bin_notation_power(size_t level)
 {
-	if (Obj == NULL)
-	{
-		return NULL;
-	}
-	if (Obj->sign < 0)
+	if (level >= BN_RADIX_LEVELS)
 	{
-		printf("\nПроверьте корректность данных\n");
 		return NULL;
 	}
-	if (Obj->sign == 0)
+
+	bn_bin const* Obj_level = (bn_bin const*)bn_cache_get(&bn_bin_notation_powers[level]);
+	if (Obj_level != NULL)
 	{
-		bn* Obj_r = bn_new();
-		return Obj_r;
+		return Obj_level;
 	}
 
-	int ind_now = (Obj->size + 1) / 2;
-
-	bn* Obj_curr = bn_new();
-	bn_add_nulls_begin(Obj_curr, ind_now);
-	Obj_curr->size = ind_now;
-	Obj_curr->sign = 1;
-	
-	--ind_now;
-	
-	bn* Obj_c = bn_new();
-	int l_hold, r_hold, curr_num, k; 
-	while (ind_now >= 0)
+	for (size_t j = 0; j <= level; ++j)
 	{
-		l_hold = 0;
-		r_hold = NOTATION;
-		curr_num = 0;
-		
-		while (l_hold <= r_hold)
+		if (bn_cache_get(&bn_bin_notation_powers[j]) != NULL)
 		{
-			k = (l_hold + r_hold) >> 1;
-			Obj_curr->ptr_body[ind_now] = k;
-
-			Analog_assignment(Obj_c, Obj_curr);
-			bn_pow_to(Obj_c, 2);
+			continue;
+		}
 
-			if (bn_cmp(Obj_c, Obj) != 1)
+		bn_bin* Obj_p = NULL;
+		if (j == 0)
+		{
+			Obj_p = bn_bin_new();
+			if (Obj_p == NULL || bn_bin_init_int(Obj_p, NOTATION) != BN_OK)
 			{
-				curr_num = k;
-				l_hold = k + 1;
+				bn_bin_delete(Obj_p);
+				return NULL;
 			}
-			else
+		}
+		else
+		{
+			// следующий уровень - квадрат предыдущего
+			bn_bin const* Obj_prev = (bn_bin const*)bn_cache_get(&bn_bin_notation_powers[j - 1]);
+			Obj_p = bn_bin_init(Obj_prev);
+			if (Obj_p == NULL || bn_bin_mul_to(Obj_p, Obj_prev) != BN_OK)
 			{
-				r_hold = k - 1;
+				bn_bin_delete(Obj_p);
+				return NULL;
 			}
 		}
-		
-		Obj_curr->ptr_body[ind_now] = curr_num;
-		--ind_now;
-	}
-
-	bn_delete(Obj_c);
 
-	int res_err = Clean_Nulls_Front(Obj_curr);
-	if (res_err != BN_OK)
-	{
-		return NULL;
+		if (!bn_cache_put(&bn_bin_notation_powers[j], Obj_p))
+		{
+			bn_bin_delete(Obj_p); // уровень уже вычислил другой поток
+		}
 	}
 
-	return Obj_curr;
+	return (bn_bin const*)bn_cache_get(&bn_bin_notation_powers[level]);
 }
 
-int bn_print(bn const* Obj)
+/* Функция для освобождения кэшей степеней оснований */
+int bn_cache_clear()
 {
-	if (Obj == NULL)
+	for (int radix = 0; radix < 37; ++radix)
 	{
-		return BN_NULL_OBJECT;
+		for (size_t j = 0; j < BN_RADIX_LEVELS; ++j)
+		{
+			bn_delete((bn*)bn_cache_take(&bn_radix_powers[radix][j]));
+		}
+	}
+	for (size_t j = 0; j < BN_RADIX_LEVELS; ++j)
+	{
+		bn_bin_delete((bn_bin*)bn_cache_take(&bn_bin_notation_powers[j]));
 	}
-
-	printf("-----------------------------------------------------------\n");
-	printf("Sign = %d\nLength = %ld\nAbsolute value = ", Obj->sign, Obj->size);
-
-	const char* str = bn_to_string(Obj, 10);
-	printf("%s", str);
-	
-
-	printf("\n-----------------------------------------------------------\n");
 
 	return BN_OK;
 }
 
-int bn_print_ASM(bn const* Obj)
+int bn_bin_from_limbs(bn_bin* Obj, const int* arr, size_t len)
 {
-	if (Obj == NULL)
+	if (len <= BN_FROM_STRING_THRESHOLD)
 	{
-		return BN_NULL_OBJECT;
-	}
+		Obj->size = 1;
+		Obj->ptr_body[0] = 0;
 
-	printf("-----------------------------------------------------------\n");
-	printf("Sign = %d\nLength = %ld\nAbsolute value = ", Obj->sign, Obj->size);
+		int res_err = bn_bin_reserve(Obj, len / 2 + 2);
+		if (res_err != BN_OK)
+		{
+			return res_err;
+		}
 
-	for (int i = 0; i != Obj->size; ++i) {
-		printf(" \\ %d \\ ", Obj->ptr_body[i]);
-	}
-	printf("\n-----------------------------------------------------------\n");
+		// схема Горнера по две ячейки BN (основание NOTATION^2 < 2^64); при нечетной длине старшая ячейка идет отдельно
+		size_t i = len;
+		if (i % 2 == 1)
+		{
+			Obj->ptr_body[0] = (unsigned int)arr[--i];
+		}
 
-	return BN_OK;
-}
+		unsigned long long big = (unsigned long long)NOTATION * NOTATION;
+		while (i > 0)
+		{
+			unsigned long long chunk = (unsigned long long)(unsigned int)arr[i - 1] * NOTATION + (unsigned int)arr[i - 2];
+			i -= 2;
 
-char* GetStr()
-{
-	int size = 0;
-	int capacity = 50;
+			unsigned long long flag = bn_bin_limbs_mul_1(Obj->ptr_body, Obj->ptr_body, Obj->size, big);
+			flag += bn_bin_limbs_add(Obj->ptr_body, Obj->ptr_body, Obj->size, &chunk, 1);
+			if (flag != 0)
+			{
+				Obj->ptr_body[Obj->size++] = flag;
+			}
+		}
 
-	char* str = (char*)malloc(capacity * sizeof(char));
-	char c = getchar();
-	if (c == '\n')
-	{
-		c = getchar();
+		Obj->sign = 1;
+		bn_bin_normalize(Obj);
+		return BN_OK;
 	}
 
-	while (c != '\n')
+	// младшая половина - 2^level ячеек, где 2^level < len <= 2^(level + 1)
+	size_t level = 0;
+	while (((size_t)2 << level) < len)
 	{
-		str[size++] = c;
+		++level;
+	}
+	size_t len_low = (size_t)1 << level;
 
-		if (size >= capacity)
-		{
-			capacity *= 2;
-			str = (char*)realloc(str, capacity * sizeof(char));
-		}
+	bn_bin const* Obj_p = bn_bin_notation_power(level);
+	bn_bin* Obj_low = bn_bin_new();
+	if (Obj_p == NULL || Obj_low == NULL)
+	{
+		bn_bin_delete(Obj_low);
+		return BN_NO_MEMORY;
+	}
 
-		c = getchar();
+	int res_err = bn_bin_from_limbs(Obj, arr + len_low, len - len_low);
+	if (res_err == BN_OK)
+	{
+		res_err = bn_bin_from_limbs(Obj_low, arr, len_low);
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = bn_bin_mul_to(Obj, Obj_p);
+	}
+	if (res_err == BN_OK)
+	{
+		res_err = bn_bin_add_to(Obj, Obj_low);
 	}
-	str = (char*)realloc(str, (size + 1) * sizeof(char));
-	str[size] = '\0';
 
-	return str;
+	bn_bin_delete(Obj_low);
+	return res_err;
 }
 
 int main() {
@@ -1834,6 +7669,24 @@ int main() {
 	code = bn_neg(b); // b = -999;
 	int bsign = bn_sign(b); // bsign = -1
 	code = bn_abs(b); // b = 999;
+
+#ifdef BN_COUNT_ALLOC
+	// квадраты и степени коротких чисел на месте не выделяют память из кучи
+	size_t allocs = bn_alloc_count;
+	for (int i = 0; i < 1000; ++i)
+	{
+		code = bn_init_int(b, 12345);
+		code = bn_sqr_to(b); // b = 12345^2
+		code = bn_mul_to(b, b); // b = 12345^4
+		code = bn_init_int(b, 7);
+		code = bn_pow_to(b, 20); // b = 7^20
+	}
+	if (bn_alloc_count != allocs)
+	{
+		printf("short sqr/pow: %zu allocations\n", bn_alloc_count - allocs);
+	}
+#endif
+
 	bn_delete(f); // Gабудете удалит+ - провалите тесты
 	bn_delete(e);
 	bn_delete(d);
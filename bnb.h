@@ -1,11 +1,13 @@
 #ifndef bnb
 #define bnb
 
+#include <stddef.h>
+
 struct bn_s;
 typedef struct bn_s bn;
 
 enum bn_codes {
-	BN_OK, BN_NULL_OBJECT, BN_NO_MEMORY, BN_DIVIDE_BY_ZERO
+	BN_OK, BN_NULL_OBJECT, BN_NO_MEMORY, BN_DIVIDE_BY_ZERO, BN_INVALID_ARGUMENT
 };
 
 bn* bn_new(); // Создать новое BN
@@ -16,14 +18,23 @@ int bn_init_string(bn*, const char*);
 
 // Инициализировать значение BN представлением строки
 // в системе счисления: radix
+// (radix вне 2..36 или символ, не являющийся цифрой, - BN_INVALID_ARGUMENT, значение BN не меняется)
 int bn_init_string_radix(bn*, const char*, int);
 
 // Инициализировать значение BN заданным целым числом
 int bn_init_int(bn*, int);
+int bn_init_int64(bn*, long long);
+int bn_init_uint64(bn*, unsigned long long);
 
 // Уничтожить BN (освободить память)
 int bn_delete(bn*);
 
+// Зарезервировать память под capacity ячеек, не меняя значения BN
+int bn_reserve(bn*, size_t);
+
+// Освободить память, не занятую значением BN
+int bn_shrink_to_fit(bn*);
+
 // Операции, аналогичные +=, -=, *=, /=, %=
 int bn_add_to(bn*, bn const*);
 int bn_sub_to(bn*, bn const*);
@@ -31,12 +42,73 @@ int bn_mul_to(bn*, bn const*);
 int bn_div_to(bn*, bn const*); 
 int bn_mod_to(bn*, bn const*); 
 
+// Операции dst = l+r (l-r, l*r, l/r, l%r) с записью в уже созданный dst (его память переиспользуется).
+// dst может совпадать с любым из операндов
+int bn_add_into(bn*, bn const*, bn const*);
+int bn_sub_into(bn*, bn const*, bn const*);
+int bn_mul_into(bn*, bn const*, bn const*);
+int bn_div_into(bn*, bn const*, bn const*);
+int bn_mod_into(bn*, bn const*, bn const*);
+
+// Квадрат числа: на месте, с записью в dst (dst может совпадать с аргументом) и в новый BN.
+// bn_mul_to(a, a) и bn_mul_into(dst, a, a) считают квадрат так же
+int bn_sqr_to(bn*);
+int bn_sqr_into(bn*, bn const*);
+bn* bn_sqr(bn const*);
+
+// Частное и остаток за одно деление: q = l / r с округлением вниз, остаток l - q * r
+// (знак остатка совпадает со знаком делителя). Один из результатов может быть NULL
+int bn_divmod(bn*, bn*, bn const*, bn const*);
+
+// Операции с 64-битным целым без выделения временных BN: +=, -=, *=
+int bn_add_si(bn*, long long);
+int bn_sub_si(bn*, long long);
+int bn_mul_si(bn*, long long);
+
+// Частное (с округлением вниз) и остаток от деления на 64-битное целое.
+// Частное может совпадать с делимым или быть NULL, остаток может быть NULL
+int bn_divmod_si(bn*, long long*, bn const*, long long);
+
+// Сравнение с 64-битным целым: <0, 0 или >0
+int bn_cmp_si(bn const*, long long);
+
 // Возвести число в степень degree
 int bn_pow_to(bn*, int);
 
-// Извлечь корень степени reciprocal из BN
+// Возвести в степень по модулю: result = base^exp mod m (знак результата - как у m); при exp < 0
+// основание должно быть обратимо по модулю m, иначе - BN_DIVIDE_BY_ZERO. result может совпадать с любым из аргументов
+int bn_powmod(bn*, bn const*, bn const*, bn const*);
+
+// Целый квадратный корень с остатком: x = s^2 + r, 0 <= r <= 2s (x >= 0).
+// Один из результатов может быть NULL, результаты могут совпадать с x
+int bn_sqrtrem(bn*, bn*, bn const*);
+
+// Целый корень степени k с остатком: x = s^k + r, корень округляется к нулю (k >= 1; при четном k x >= 0).
+// Один из результатов может быть NULL, результаты могут совпадать с x
+int bn_rootrem(bn*, bn*, bn const*, int);
+
+// Извлечь корень степени reciprocal из BN (reciprocal < 1 или четная степень отрицательного числа - BN_INVALID_ARGUMENT)
 int bn_root_to(bn*, int); //---------------------------------------------------------------------------------
 
+// Числа Фибоначчи и Люка: F(0) = 0, F(1) = 1; L(0) = 2, L(1) = 1 (num может быть отрицательным)
+int bn_fib(bn*, long long);
+int bn_lucas(bn*, long long);
+
+// Факториал, биномиальный коэффициент C(n, k), праймориал (произведение простых до n)
+// и произведение lo * (lo + 1) * ... * hi (1, если lo > hi); считаются деревом произведений
+int bn_fac(bn*, long long);
+int bn_binomial(bn*, long long, long long);
+int bn_primorial(bn*, long long);
+int bn_prod_range(bn*, long long, long long);
+
+// Наибольший общий делитель (неотрицательный) и коэффициенты Безу: g = s * a + t * b (s или t может быть NULL).
+// Результаты могут совпадать с аргументами
+int bn_gcd(bn*, bn const*, bn const*);
+int bn_gcdext(bn*, bn*, bn*, bn const*, bn const*);
+
+// Обратный по модулю: a * r = 1 mod m (знак r - как у m); если обратного нет - BN_DIVIDE_BY_ZERO
+int bn_invert(bn*, bn const*, bn const*);
+
 // Аналоги операций x = l+r (l-r, l*r, l/r, l%r)
 bn* bn_add(bn const*, bn const*);
 bn* bn_sub(bn const*, bn const*);
@@ -45,9 +117,14 @@ bn* bn_div(bn const*, bn const*);
 bn* bn_mod(bn const*, bn const*); 
 
 // Выдать представление BN в системе счисления radix в виде строки
-// Строку после использования потребуется удалить.
+// Строку после использования потребуется удалить. При radix вне 2..36 - NULL
 char* bn_to_string(bn const*, int); //---------------------------------------------------------------------------------
 
+// Освободить кэши степеней оснований, которые переводы в строку и из строки заполняют при первом обращении
+// (например, перед выходом из программы). Вызывать, когда другие потоки не работают с BN; в сборке
+// без атомарных операций C11 кэши у каждого потока свои, и освобождаются кэши вызывающего потока
+int bn_cache_clear();
+
 // Если левое меньше, вернуть <0; если равны, вернуть 0; иначе >0
 int bn_cmp(bn const*, bn const*);
 
@@ -55,4 +132,185 @@ int bn_neg(bn*); // Изменить знак на противоположны
 int bn_abs(bn*); // Вернуть модуль
 int bn_sign(bn const*); //-1 если t<0; 0 если t = 0, 1 если t>0
 
+// Контекст (арена): BN и временные массивы выделяются из него подряд и освобождаются разом;
+// освобожденное раньше (bn_delete, временная память операций) контекст использует повторно.
+// Контекст операции свой у каждого потока: потоки могут одновременно работать каждый со своим контекстом,
+// но один контекст нельзя использовать из нескольких потоков сразу
+struct bn_ctx_s;
+typedef struct bn_ctx_s bn_ctx;
+
+bn_ctx* bn_ctx_new(); // Создать пустой контекст
+int bn_ctx_clear(bn_ctx*); // Освободить все, что выделено из контекста (контекст остается пригодным)
+int bn_ctx_delete(bn_ctx*); // Уничтожить контекст вместе со всеми BN, созданными в нем
+bn* bn_ctx_bn_new(bn_ctx*); // Создать BN в контексте (bn_delete возвращает его память контексту)
+bn* bn_init_ctx(bn const*, bn_ctx*); // Создать копию BN в контексте
+
+// Варианты операций, берущие временную память из контекста
+int bn_add_to_ctx(bn*, bn const*, bn_ctx*);
+int bn_sub_to_ctx(bn*, bn const*, bn_ctx*);
+int bn_mul_to_ctx(bn*, bn const*, bn_ctx*);
+int bn_div_to_ctx(bn*, bn const*, bn_ctx*);
+int bn_mod_to_ctx(bn*, bn const*, bn_ctx*);
+int bn_divmod_ctx(bn*, bn*, bn const*, bn const*, bn_ctx*);
+int bn_pow_to_ctx(bn*, int, bn_ctx*);
+int bn_root_to_ctx(bn*, int, bn_ctx*);
+int bn_add_into_ctx(bn*, bn const*, bn const*, bn_ctx*);
+int bn_sub_into_ctx(bn*, bn const*, bn const*, bn_ctx*);
+int bn_mul_into_ctx(bn*, bn const*, bn const*, bn_ctx*);
+int bn_div_into_ctx(bn*, bn const*, bn const*, bn_ctx*);
+int bn_mod_into_ctx(bn*, bn const*, bn const*, bn_ctx*);
+int bn_sqr_to_ctx(bn*, bn_ctx*);
+int bn_sqr_into_ctx(bn*, bn const*, bn_ctx*);
+int bn_add_si_ctx(bn*, long long, bn_ctx*);
+int bn_sub_si_ctx(bn*, long long, bn_ctx*);
+int bn_mul_si_ctx(bn*, long long, bn_ctx*);
+int bn_divmod_si_ctx(bn*, long long*, bn const*, long long, bn_ctx*);
+int bn_powmod_ctx(bn*, bn const*, bn const*, bn const*, bn_ctx*);
+int bn_sqrtrem_ctx(bn*, bn*, bn const*, bn_ctx*);
+int bn_rootrem_ctx(bn*, bn*, bn const*, int, bn_ctx*);
+int bn_fib_ctx(bn*, long long, bn_ctx*);
+int bn_lucas_ctx(bn*, long long, bn_ctx*);
+int bn_fac_ctx(bn*, long long, bn_ctx*);
+int bn_binomial_ctx(bn*, long long, long long, bn_ctx*);
+int bn_primorial_ctx(bn*, long long, bn_ctx*);
+int bn_prod_range_ctx(bn*, long long, long long, bn_ctx*);
+int bn_gcd_ctx(bn*, bn const*, bn const*, bn_ctx*);
+int bn_gcdext_ctx(bn*, bn*, bn*, bn const*, bn const*, bn_ctx*);
+int bn_invert_ctx(bn*, bn const*, bn const*, bn_ctx*);
+int bn_init_string_ctx(bn*, const char*, bn_ctx*);
+int bn_init_string_radix_ctx(bn*, const char*, int, bn_ctx*);
+
+// Вывод с временной памятью из контекста: строка выделяется в куче, ее потребуется удалить
+char* bn_to_string_ctx(bn const*, int, bn_ctx*);
+
+// Сравнения, смена знака, модуль и знак памяти не выделяют, вариантов с контекстом у них нет.
+// Варианты для операций Монтгомери и Барретта объявлены ниже, рядом с ними.
+// Числа bn_bin всегда выделяются в куче, вариантов с контекстом у них нет
+
+// Варианты x = l+r (l-r, l*r, l/r, l%r), создающие результат в контексте
+bn* bn_add_ctx(bn const*, bn const*, bn_ctx*);
+bn* bn_sub_ctx(bn const*, bn const*, bn_ctx*);
+bn* bn_mul_ctx(bn const*, bn const*, bn_ctx*);
+bn* bn_div_ctx(bn const*, bn const*, bn_ctx*);
+bn* bn_mod_ctx(bn const*, bn const*, bn_ctx*);
+bn* bn_sqr_ctx(bn const*, bn_ctx*);
+
+// Контекст Монтгомери: все вычисляется для одного модуля m > 0, не делящегося на 2 и на 5
+// (основание NOTATION = 10^9). Числа в форме Монтгомери - это a * R mod m, R = 10^(9n), n - длина m.
+// Умножение в этой форме приводит произведение без деления на m. Операции не изменяют контекст,
+// поэтому один контекст можно использовать из нескольких потоков одновременно
+struct bn_mont_ctx_s;
+typedef struct bn_mont_ctx_s bn_mont_ctx;
+
+bn_mont_ctx* bn_mont_ctx_new(bn const*); // Создать контекст для модуля (NULL, если модуль не подходит)
+int bn_mont_ctx_delete(bn_mont_ctx*); // Уничтожить контекст
+
+int bn_mont_to(bn*, bn const*, bn_mont_ctx const*); // dst = a * R mod m (a - любое)
+int bn_mont_from(bn*, bn const*, bn_mont_ctx const*); // dst = a * R^(-1) mod m (обратный перевод)
+
+// Умножение и квадрат в форме Монтгомери: dst = a * b * R^(-1) mod m (0 <= a, b < m, dst может совпадать с аргументами)
+int bn_mont_mul(bn*, bn const*, bn const*, bn_mont_ctx const*);
+int bn_mont_sqr(bn*, bn const*, bn_mont_ctx const*);
+
+// Варианты операций Монтгомери с временной памятью из контекста (сам контекст Монтгомери создается в куче)
+bn_mont_ctx* bn_mont_ctx_new_ctx(bn const*, bn_ctx*);
+int bn_mont_to_ctx(bn*, bn const*, bn_mont_ctx const*, bn_ctx*);
+int bn_mont_from_ctx(bn*, bn const*, bn_mont_ctx const*, bn_ctx*);
+int bn_mont_mul_ctx(bn*, bn const*, bn const*, bn_mont_ctx const*, bn_ctx*);
+int bn_mont_sqr_ctx(bn*, bn const*, bn_mont_ctx const*, bn_ctx*);
+
+// Приведение по Барретту для одного модуля m != 0 (любого): остаток x mod m считается двумя умножениями
+// на заранее найденную обратную величину m и вычитанием. Рассчитано на |x| < m^2 (например, произведение
+// двух остатков); большие x приводятся обычным делением. Знак остатка - как у m (как в bn_divmod).
+// Приведение не изменяет подготовленную структуру, поэтому ее можно использовать из нескольких потоков
+struct bn_barrett_s;
+typedef struct bn_barrett_s bn_barrett;
+
+bn_barrett* bn_barrett_init(bn const*); // Подготовить приведение по модулю (NULL при m = 0 или нехватке памяти)
+int bn_barrett_delete(bn_barrett*); // Уничтожить подготовленное приведение
+int bn_barrett_reduce(bn*, bn const*, bn_barrett const*); // dst = x mod m (dst может совпадать с x)
+bn_barrett* bn_barrett_init_ctx(bn const*, bn_ctx*); // то же с временной памятью из контекста (структура - в куче)
+int bn_barrett_reduce_ctx(bn*, bn const*, bn_barrett const*, bn_ctx*); // то же с временной памятью из контекста
+
+// Низкоуровневый слой: беззнаковые числа как массивы ячеек (младшая ячейка первая, каждая ячейка - от 0
+// до BN_LIMB_BASE - 1). Функции не выделяют память и не проверяют аргументы: результат пишется в массив
+// вызывающего, достаточной длины; r может совпадать с a (и с b, где это указано)
+#define BN_LIMB_BASE 1000000000
+#define BN_LIMB_DIGITS 9
+
+// r = a + b и r = a - b по n ячейкам (r может совпадать с a и b), возвращается перенос (заем): 0 или 1
+int bn_limbs_add_n(int* r, const int* a, const int* b, size_t n);
+int bn_limbs_sub_n(int* r, const int* a, const int* b, size_t n);
+
+// r = a + d и r = a - d по n ячейкам (0 <= d < BN_LIMB_BASE), возвращается перенос (заем)
+int bn_limbs_add_1(int* r, const int* a, size_t n, int d);
+int bn_limbs_sub_1(int* r, const int* a, size_t n, int d);
+
+// r = a + b и r = a - b, na >= nb, в r записывается na ячеек, возвращается перенос (заем)
+int bn_limbs_add(int* r, const int* a, size_t na, const int* b, size_t nb);
+int bn_limbs_sub(int* r, const int* a, size_t na, const int* b, size_t nb);
+
+// r = a * d, r += a * d, r -= a * d по n ячейкам (0 <= d < BN_LIMB_BASE), возвращается перенос (заем) из старшей ячейки
+int bn_limbs_mul_1(int* r, const int* a, size_t n, int d);
+int bn_limbs_addmul_1(int* r, const int* a, size_t n, int d);
+int bn_limbs_submul_1(int* r, const int* a, size_t n, int d);
+
+// q = a / d (0 < d < BN_LIMB_BASE), в q записывается n ячеек, возвращается остаток
+int bn_limbs_divrem_1(int* q, const int* a, size_t n, int d);
+
+// Сравнение массивов одинаковой длины: <0, 0 или >0
+int bn_limbs_cmp(const int* a, const int* b, size_t n);
+
+// Длина массива без ведущих нулевых ячеек (0 для нуля)
+size_t bn_limbs_normalize(const int* a, size_t n);
+
+// r = a * b и r = a * a школьным методом (r не пересекается с a и b), в r записывается na + nb (2n) ячеек
+void bn_limbs_mul_basecase(int* r, const int* a, size_t na, const int* b, size_t nb);
+void bn_limbs_sqr_basecase(int* r, const int* a, size_t n);
+
+// Доступ к ячейкам BN: чтение (длина - bn_limbs_size, без ведущих нулей), запись не меньше n ячеек
+// (NULL при нехватке памяти) и завершение записи: у BN становится n ячеек и знак sign, ведущие нули отбрасываются
+const int* bn_limbs_read(bn const*);
+size_t bn_limbs_size(bn const*);
+int* bn_limbs_write(bn*, size_t);
+int bn_limbs_finish(bn*, size_t, int);
+
+// Число с двоичными ячейками по 64 бита (произведения считаются в 128-битных целых, а где их нет - по 32-битным половинам).
+// Десятичное представление нужно только при вводе и выводе, арифметика идет без делений на 10^9
+struct bn_bin_s;
+typedef struct bn_bin_s bn_bin;
+
+bn_bin* bn_bin_new(); // Создать новое число (равное 0)
+bn_bin* bn_bin_init(bn_bin const*); // Создать копию существующего числа
+int bn_bin_delete(bn_bin*); // Уничтожить число (освободить память)
+int bn_bin_reserve(bn_bin*, size_t); // Зарезервировать память под заданное количество ячеек
+
+// Инициализировать значение целым числом, строкой (десятичной или в системе счисления radix);
+// radix вне 2..36 или символ, не являющийся цифрой, - BN_INVALID_ARGUMENT
+int bn_bin_init_int(bn_bin*, long long);
+int bn_bin_init_string(bn_bin*, const char*);
+int bn_bin_init_string_radix(bn_bin*, const char*, int);
+
+// Выдать представление в системе счисления radix в виде строки (строку потребуется удалить; radix вне 2..36 - NULL)
+char* bn_bin_to_string(bn_bin const*, int);
+
+// Перевод между BN и числом с двоичными ячейками
+int bn_bin_from_bn(bn_bin*, bn const*);
+int bn_bin_to_bn(bn*, bn_bin const*);
+
+// Операции, аналогичные +=, -=, *=, /=, %= (деление с округлением вниз, как у BN)
+int bn_bin_add_to(bn_bin*, bn_bin const*);
+int bn_bin_sub_to(bn_bin*, bn_bin const*);
+int bn_bin_mul_to(bn_bin*, bn_bin const*);
+int bn_bin_div_to(bn_bin*, bn_bin const*);
+int bn_bin_mod_to(bn_bin*, bn_bin const*);
+
+// Частное и остаток за одно деление (один из результатов может быть NULL)
+int bn_bin_divmod(bn_bin*, bn_bin*, bn_bin const*, bn_bin const*);
+
+int bn_bin_cmp(bn_bin const*, bn_bin const*); // Если левое меньше, вернуть <0; если равны, вернуть 0; иначе >0
+int bn_bin_neg(bn_bin*); // Изменить знак на противоположный
+int bn_bin_abs(bn_bin*); // Вернуть модуль
+int bn_bin_sign(bn_bin const*); //-1 если t<0; 0 если t = 0, 1 если t>0
+
 #endif